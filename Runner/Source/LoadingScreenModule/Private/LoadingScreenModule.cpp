@@ -5,9 +5,12 @@
 
 #define LOCTEXT_NAMESPACE "FLoadingScreenModuleModule"
 
+LLM_DEFINE_TAG(Runner_LoadingScreen);
+
 void FLoadingScreenModule::StartupModule()
 {
     UE_LOG(LogTemp, Display, TEXT("FLoadingScreenModuleModule::StartupModule"));
+    LLM_SCOPE_BYTAG(Runner_LoadingScreen);
 
     // Load the background texture, which will be used for the loading screen
     if (ULevelLoadingSettings* LoadingSettings = GetMutableDefault<ULevelLoadingSettings>())
@@ -18,6 +21,9 @@ void FLoadingScreenModule::StartupModule()
             BackgroundTexture = Cast<UTexture2D>(StaticLoadObject(UTexture2D::StaticClass(), nullptr, *BGPath.ToString()));
         }
     }
+
+    // Dismiss the loading screen when the warm-up stage releases it
+    Warmup.OnFinished().AddRaw(this, &FLoadingScreenModule::StopLoadingScreen);
 }
 
 bool FLoadingScreenModule::IsGameModule() const
@@ -28,6 +34,7 @@ bool FLoadingScreenModule::IsGameModule() const
 void FLoadingScreenModule::StartLoadingScreen(const FString& MapName)
 {
     UE_LOG(LogTemp, Display, TEXT("FLoadingScreenModuleModule::StartLoadingScreen"));
+    LLM_SCOPE_BYTAG(Runner_LoadingScreen);
     
     // boolean to indicate if this map should show a loading screen
     bool bShouldShowLoadingScreen = false;
@@ -51,17 +58,37 @@ void FLoadingScreenModule::StartLoadingScreen(const FString& MapName)
         return;
     }
 
+    // Hold the loading screen while warm-up tasks registered during the load are running
+    Warmup.Begin(LoadingSettings->WarmupBudgetSeconds, LoadingSettings->WarmupSliceMilliseconds, LoadingSettings->MinLoadingScreenDisplayTime);
+
     // Create a struct to hold all our loading screen settings
+    // The engine keeps ticking after the map is loaded so warm-up can run, the warm-up stage stops the screen
     FLoadingScreenAttributes LoadingScreen;
     LoadingScreen.bAutoCompleteWhenLoadingCompletes = false;
-    LoadingScreen.MinimumLoadingScreenDisplayTime = LoadingSettings->MinLoadingScreenDisplayTime;
-    LoadingScreen.WidgetLoadingScreen = SNew(SLoadingScreen).BackgroundTexture(BackgroundTexture);
+    LoadingScreen.bWaitForManualStop = true;
+    LoadingScreen.bAllowEngineTick = true;
+    LoadingScreen.MinimumLoadingScreenDisplayTime = -1.0f;
+    LoadingScreen.WidgetLoadingScreen = SNew(SLoadingScreen)
+        .BackgroundTexture(BackgroundTexture)
+        .Progress_Raw(&Warmup, &FLoadingScreenWarmup::GetDisplayProgress);
     GetMoviePlayer()->SetupLoadingScreen(LoadingScreen);
 }
 
+void FLoadingScreenModule::StopLoadingScreen()
+{
+    UE_LOG(LogTemp, Display, TEXT("FLoadingScreenModuleModule::StopLoadingScreen"));
+
+    if (IsMoviePlayerEnabled())
+    {
+        GetMoviePlayer()->StopMovie();
+    }
+}
+
 void FLoadingScreenModule::ShutdownModule()
 {
     UE_LOG(LogTemp, Display, TEXT("FLoadingScreenModuleModule::ShutdownModule"));
+
+    Warmup.OnFinished().RemoveAll(this);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,134 @@
+#include "LoadingScreenWarmup.h"
+
+FLoadingScreenWarmup::~FLoadingScreenWarmup()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    }
+}
+
+void FLoadingScreenWarmup::RegisterTask(FName TaskName, FWarmupStep&& Step, float Weight)
+{
+    if (!Step)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FLoadingScreenWarmup::RegisterTask: %s has no step function"), *TaskName.ToString());
+        return;
+    }
+
+    // A step registering a task must not reallocate the tasks being stepped
+    FWarmupTask& Task = bStepping ? RegisteredWhileStepping.AddDefaulted_GetRef() : Tasks.AddDefaulted_GetRef();
+    Task.Name = TaskName;
+    Task.Step = MoveTemp(Step);
+    Task.Weight = FMath::Max(Weight, KINDA_SMALL_NUMBER);
+    TotalWeight += Task.Weight;
+
+    UpdateProgress();
+    EnsureTicker();
+}
+
+void FLoadingScreenWarmup::Begin(float InBudgetSeconds, float InSliceMilliseconds, float InMinDisplaySeconds)
+{
+    BudgetSeconds = FMath::Max(InBudgetSeconds, 0.0f);
+    SliceSeconds = FMath::Max(InSliceMilliseconds, 0.1f) / 1000.0f;
+    MinDisplaySeconds = FMath::Max(InMinDisplaySeconds, 0.0f);
+    BeginTime = FPlatformTime::Seconds();
+    bHoldingLoadingScreen = true;
+
+    // Progress only covers work left over and work registered from now on
+    CompletedWeight = 0.0f;
+    TotalWeight = 0.0f;
+    for (const FWarmupTask& Task : Tasks)
+    {
+        TotalWeight += Task.Weight;
+    }
+
+    UpdateProgress();
+    EnsureTicker();
+}
+
+TOptional<float> FLoadingScreenWarmup::GetDisplayProgress() const
+{
+    return DisplayProgress.load(std::memory_order_relaxed);
+}
+
+void FLoadingScreenWarmup::EnsureTicker()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLoadingScreenWarmup::Tick));
+    }
+}
+
+bool FLoadingScreenWarmup::Tick(float DeltaTime)
+{
+    // Step the tasks round-robin until the time slice is used up
+    const double SliceEnd = FPlatformTime::Seconds() + SliceSeconds;
+    bStepping = true;
+    while (Tasks.Num() > 0 && FPlatformTime::Seconds() < SliceEnd)
+    {
+        for (int32 i = Tasks.Num() - 1; i >= 0; --i)
+        {
+            FWarmupTask& Task = Tasks[i];
+            Task.Progress = FMath::Clamp(Task.Step(), 0.0f, 1.0f);
+            if (Task.Progress >= 1.0f)
+            {
+                UE_LOG(LogTemp, Display, TEXT("FLoadingScreenWarmup: %s finished"), *Task.Name.ToString());
+                CompletedWeight += Task.Weight;
+                Tasks.RemoveAt(i);
+            }
+        }
+    }
+    bStepping = false;
+    Tasks.Append(MoveTemp(RegisteredWhileStepping));
+    RegisteredWhileStepping.Reset();
+
+    UpdateProgress();
+
+    if (bHoldingLoadingScreen)
+    {
+        const double Elapsed = FPlatformTime::Seconds() - BeginTime;
+        if (Tasks.Num() == 0 && Elapsed >= MinDisplaySeconds)
+        {
+            ReleaseLoadingScreen(false);
+        }
+        else if (Elapsed >= FMath::Max(BudgetSeconds, MinDisplaySeconds))
+        {
+            ReleaseLoadingScreen(true);
+        }
+    }
+
+    // Keep ticking while there is anything left to do
+    if (Tasks.Num() == 0 && !bHoldingLoadingScreen)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FLoadingScreenWarmup::UpdateProgress()
+{
+    float Progress = CompletedWeight;
+    for (const FWarmupTask& Task : Tasks)
+    {
+        Progress += Task.Weight * Task.Progress;
+    }
+    DisplayProgress.store(TotalWeight > 0.0f ? Progress / TotalWeight : 1.0f, std::memory_order_relaxed);
+}
+
+void FLoadingScreenWarmup::ReleaseLoadingScreen(bool bBudgetExpired)
+{
+    bHoldingLoadingScreen = false;
+
+    if (bBudgetExpired)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FLoadingScreenWarmup: budget of %.2fs expired with %d tasks pending, continuing in background"), BudgetSeconds, Tasks.Num());
+    }
+    else
+    {
+        UE_LOG(LogTemp, Display, TEXT("FLoadingScreenWarmup: finished in %.2fs"), FPlatformTime::Seconds() - BeginTime);
+    }
+
+    FinishedEvent.Broadcast();
+}
@@ -4,6 +4,7 @@
 #include "SLoadingScreen.h"
 #include "SlateOptMacros.h"
 #include "SlateExtras.h"
+#include "Widgets/Notifications/SProgressBar.h"
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SLoadingScreen::Construct(const FArguments& InArgs)
@@ -31,13 +32,28 @@ void SLoadingScreen::Construct(const FArguments& InArgs)
 			// Add second slot to the overlay for the loading indicator
 			+ SOverlay::Slot()
 			.VAlign(VAlign_Bottom)
-			.HAlign(HAlign_Center)
+			.HAlign(HAlign_Fill)
 			.Padding(10.0f)
 			[
-				// Create a throbber widget
-				SNew(SThrobber)
-					.Visibility(EVisibility::HitTestInvisible)
-					.NumPieces(20)
+				SNew(SVerticalBox)
+					// Create a throbber widget
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.HAlign(HAlign_Center)
+					[
+						SNew(SThrobber)
+							.Visibility(EVisibility::HitTestInvisible)
+							.NumPieces(20)
+					]
+					// Create a progress bar showing the warm-up progress
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(0.0f, 10.0f, 0.0f, 0.0f)
+					[
+						SNew(SProgressBar)
+							.Visibility(EVisibility::HitTestInvisible)
+							.Percent(InArgs._Progress)
+					]
 			]
 	];
 }
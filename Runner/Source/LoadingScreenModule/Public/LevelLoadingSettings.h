@@ -25,5 +25,13 @@ public:
 
 	/** Minimum duration that the loading screen will be displayed */
 	UPROPERTY(Config, EditAnywhere, Category = "Loading Screen", meta = (AllowedClasses = "World"))
-	float MinLoadingScreenDisplayTime = 3.0f;
+	float MinLoadingScreenDisplayTime = 0.5f;
+
+	/** Maximum duration the loading screen waits for warm-up tasks, remaining tasks continue after it is dismissed */
+	UPROPERTY(Config, EditAnywhere, Category = "Loading Screen|Warm-up", meta = (ClampMin = "0"))
+	float WarmupBudgetSeconds = 5.0f;
+
+	/** Time spent on warm-up tasks per frame, in milliseconds */
+	UPROPERTY(Config, EditAnywhere, Category = "Loading Screen|Warm-up", meta = (ClampMin = "0.1"))
+	float WarmupSliceMilliseconds = 8.0f;
 };
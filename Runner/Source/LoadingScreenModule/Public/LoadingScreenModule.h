@@ -2,6 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "LoadingScreenWarmup.h"
+
+/** Low-Level Memory Tracker tag of the loading screen */
+LLM_DECLARE_TAG_API(Runner_LoadingScreen, LOADINGSCREENMODULE_API);
 
 /**
  *  Loading Screen Module Implementation
@@ -22,7 +27,16 @@ public:
     /** Called when module is ended */
     virtual void ShutdownModule() override;
 
+    /** Warm-up stage, gameplay code registers tasks that run while the loading screen is displayed */
+    FLoadingScreenWarmup& GetWarmup() { return Warmup; }
+
 private:
+    /** Warm-up tasks that hold the loading screen */
+    FLoadingScreenWarmup Warmup;
+
+    /** Dismiss the loading screen once warm-up is done */
+    void StopLoadingScreen();
+
     /** Store the background texture to prevent it from being garbage collected */
     UTexture2D* BackgroundTexture;
 };
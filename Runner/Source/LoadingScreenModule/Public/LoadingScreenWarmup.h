@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+/** Broadcast once the warm-up stage no longer needs the loading screen */
+DECLARE_MULTICAST_DELEGATE(FOnLoadingScreenWarmupFinished);
+
+/**
+ *  Loading Screen Warm-up
+ *  Runs registered warm-up tasks in time slices while the loading screen is displayed.
+ *  The loading screen is held until every task reports completion or the budget expires,
+ *  unfinished tasks keep being stepped on later frames.
+ */
+class LOADINGSCREENMODULE_API FLoadingScreenWarmup
+{
+public:
+    /** Performs one step of work and returns the progress of the task in range [0, 1] */
+    using FWarmupStep = TFunction<float()>;
+
+    ~FLoadingScreenWarmup();
+
+    /** Register a task, it is stepped until it returns a progress of 1. Tasks registered by a step start on the next tick */
+    void RegisterTask(FName TaskName, FWarmupStep&& Step, float Weight = 1.0f);
+
+    /** Start holding the loading screen, called when the loading screen starts */
+    void Begin(float InBudgetSeconds, float InSliceMilliseconds, float InMinDisplaySeconds);
+
+    /** Returns true while the loading screen is held by the warm-up stage */
+    bool IsHoldingLoadingScreen() const { return bHoldingLoadingScreen; }
+
+    /** Returns true if any registered task has not completed yet */
+    bool HasPendingTasks() const { return Tasks.Num() > 0 || RegisteredWhileStepping.Num() > 0; }
+
+    /** Weighted progress of all tasks registered since Begin, safe to read from the loading screen thread */
+    TOptional<float> GetDisplayProgress() const;
+
+    /** Event triggered when the loading screen can be dismissed */
+    FOnLoadingScreenWarmupFinished& OnFinished() { return FinishedEvent; }
+
+private:
+    struct FWarmupTask
+    {
+        FName Name;
+        FWarmupStep Step;
+        float Weight = 1.0f;
+        float Progress = 0.0f;
+    };
+
+    /** Tasks that have not completed yet */
+    TArray<FWarmupTask> Tasks;
+
+    /** Tasks registered while stepping, added to Tasks once the steps are done */
+    TArray<FWarmupTask> RegisteredWhileStepping;
+
+    /** Tasks are being stepped, Tasks must not change */
+    bool bStepping = false;
+
+    /** Weight of tasks completed since Begin, used for progress */
+    float CompletedWeight = 0.0f;
+
+    /** Total weight of tasks registered since Begin, used for progress */
+    float TotalWeight = 0.0f;
+
+    /** Progress published for the loading screen widget */
+    std::atomic<float> DisplayProgress { 0.0f };
+
+    /** Time budget for holding the loading screen */
+    float BudgetSeconds = 0.0f;
+
+    /** Time spent on tasks per tick */
+    float SliceSeconds = 0.005f;
+
+    /** Loading screen stays at least this long */
+    float MinDisplaySeconds = 0.0f;
+
+    /** Time the loading screen started */
+    double BeginTime = 0.0;
+
+    bool bHoldingLoadingScreen = false;
+
+    FOnLoadingScreenWarmupFinished FinishedEvent;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    /** Make sure the ticker is running */
+    void EnsureTicker();
+
+    /** Ticker callback, steps tasks within the time slice */
+    bool Tick(float DeltaTime);
+
+    /** Recompute the published progress */
+    void UpdateProgress();
+
+    /** Release the loading screen */
+    void ReleaseLoadingScreen(bool bBudgetExpired);
+};
@@ -15,6 +15,7 @@ public:
 		: _BackgroundTexture(nullptr)						/** Default constructor initializes texture to null */
 		{}
 		SLATE_ARGUMENT(UTexture2D*, BackgroundTexture)		/** Declares texture parameter for widget */
+		SLATE_ATTRIBUTE(TOptional<float>, Progress)			/** Warm-up progress in range [0, 1] */
 	SLATE_END_ARGS()
 
 	/** Constructs this widget with InArgs */
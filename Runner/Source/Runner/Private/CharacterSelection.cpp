@@ -5,6 +5,8 @@
 #include "RunnerCharacter.h"
 #include "RunnerGameInstance.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Components/SceneComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 
@@ -30,8 +32,9 @@ void ACharacterSelection::BeginPlay()
 	// Set Default Character from array index 0
 	if (CharacterMeshArray.Num() > 0)
 	{
-		SkeletalMesh->SetSkeletalMesh(CharacterMeshArray[CurrentIndex]);
-		SaveSelectedCharacter();
+		bSaveWhenShown = true;
+		UpdateCharacterStreaming();
+		ShowCurrentCharacter();
 	}
 	else
 	{
@@ -39,16 +42,41 @@ void ACharacterSelection::BeginPlay()
 	}
 }
 
+void ACharacterSelection::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Release all streamed characters
+	for (TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : CharacterHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	CharacterHandles.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ACharacterSelection::PrevCharacter()
 {
-	CurrentIndex = (CurrentIndex - 1 + CharacterMeshArray.Num()) % CharacterMeshArray.Num();
-	SkeletalMesh->SetSkeletalMesh(CharacterMeshArray[CurrentIndex]);
+	if (CharacterMeshArray.Num() == 0)
+	{
+		return;
+	}
+	CurrentIndex = WrapIndex(CurrentIndex - 1);
+	UpdateCharacterStreaming();
+	ShowCurrentCharacter();
 }
 
 void ACharacterSelection::NextCharacter()
 {
-	CurrentIndex = (CurrentIndex + 1) % CharacterMeshArray.Num();
-	SkeletalMesh->SetSkeletalMesh(CharacterMeshArray[CurrentIndex]);
+	if (CharacterMeshArray.Num() == 0)
+	{
+		return;
+	}
+	CurrentIndex = WrapIndex(CurrentIndex + 1);
+	UpdateCharacterStreaming();
+	ShowCurrentCharacter();
 }
 
 void ACharacterSelection::SaveSelectedCharacter()
@@ -60,8 +88,100 @@ void ACharacterSelection::SaveSelectedCharacter()
 		if (!MyGameInstance)
 		{
 			UE_LOG(LogTemp, Error, TEXT("MyGameInstance is NULL"));
+			return;
 		}
 	}
-	MyGameInstance->PlayerCharacterClass = CharacterPawnArray[CurrentIndex];
+
+	if (!CharacterPawnArray.IsValidIndex(CurrentIndex))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CharacterPawnArray has no entry for index %d"), CurrentIndex);
+		return;
+	}
+
+	// The shown character is normally streamed in already, only block if the player confirms before it arrives
+	const TSoftClassPtr<ACharacter>& PawnClass = CharacterPawnArray[CurrentIndex];
+	MyGameInstance->PlayerCharacterClass = PawnClass.IsValid() ? PawnClass.Get() : PawnClass.LoadSynchronous();
 }
 
+void ACharacterSelection::UpdateCharacterStreaming()
+{
+	// Keep the current character and its neighbors
+	TSet<int32> WantedIndices;
+	WantedIndices.Add(CurrentIndex);
+	WantedIndices.Add(WrapIndex(CurrentIndex - 1));
+	WantedIndices.Add(WrapIndex(CurrentIndex + 1));
+
+	// Release characters that are no longer needed
+	for (auto It = CharacterHandles.CreateIterator(); It; ++It)
+	{
+		if (!WantedIndices.Contains(It.Key()))
+		{
+			if (It.Value().IsValid())
+			{
+				It.Value()->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const int32 Index : WantedIndices)
+	{
+		if (!CharacterHandles.Contains(Index))
+		{
+			RequestCharacter(Index);
+		}
+	}
+}
+
+void ACharacterSelection::RequestCharacter(int32 Index)
+{
+	TArray<FSoftObjectPath> AssetPaths;
+	if (CharacterMeshArray.IsValidIndex(Index) && !CharacterMeshArray[Index].IsNull())
+	{
+		AssetPaths.Add(CharacterMeshArray[Index].ToSoftObjectPath());
+	}
+	if (CharacterPawnArray.IsValidIndex(Index) && !CharacterPawnArray[Index].IsNull())
+	{
+		AssetPaths.Add(CharacterPawnArray[Index].ToSoftObjectPath());
+	}
+	if (AssetPaths.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Character %d has no assets to stream"), Index);
+		return;
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	CharacterHandles.Add(Index, StreamableManager.RequestAsyncLoad(
+		AssetPaths,
+		FStreamableDelegate::CreateUObject(this, &ACharacterSelection::OnCharacterLoaded, Index),
+		FStreamableManager::AsyncLoadHighPriority));
+}
+
+void ACharacterSelection::ShowCurrentCharacter()
+{
+	const TSharedPtr<FStreamableHandle>* Handle = CharacterHandles.Find(CurrentIndex);
+	if (Handle && Handle->IsValid() && (*Handle)->HasLoadCompleted())
+	{
+		SkeletalMesh->SetSkeletalMesh(CharacterMeshArray[CurrentIndex].Get());
+		if (bSaveWhenShown)
+		{
+			bSaveWhenShown = false;
+			SaveSelectedCharacter();
+		}
+	}
+}
+
+void ACharacterSelection::OnCharacterLoaded(int32 Index)
+{
+	// Ignore characters the player has already moved past
+	if (Index == CurrentIndex)
+	{
+		ShowCurrentCharacter();
+	}
+}
+
+int32 ACharacterSelection::WrapIndex(int32 Index) const
+{
+	const int32 Num = CharacterMeshArray.Num();
+	return Num > 0 ? (Index % Num + Num) % Num : 0;
+}
@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerAutopilotController.h"
+#include "RunnerCharacter.h"
+#include "RunnerFloorActor.h"
+#include "RunnerGameMode.h"
+#include "RunnerSimulationComponent.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTileManager.h"
+
+#include "Components/ChildActorComponent.h"
+#include "Misc/CommandLine.h"
+
+ARunnerAutopilotController::ARunnerAutopilotController()
+{
+	// Keep ticking while the game is paused after a death so the run can be resumed
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bTickEvenWhenPaused = true;
+}
+
+void ARunnerAutopilotController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	MyGameMode = Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode());
+
+	ApplyCommandLine(FCommandLine::Get());
+	RandomStream.Initialize(bDeterministic ? Seed : FMath::Rand());
+
+	UE_LOG(LogTemp, Display, TEXT("ARunnerAutopilotController: skill %.2f, seed %d%s, session %s"),
+		Settings.Skill, RandomStream.GetInitialSeed(), bDeterministic ? TEXT(" (deterministic)") : TEXT(""),
+		SessionDuration > 0 ? *FString::Printf(TEXT("%.0fs"), SessionDuration) : TEXT("unlimited"));
+}
+
+void ARunnerAutopilotController::ApplyCommandLine(const TCHAR* CommandLine)
+{
+	if (FParse::Value(CommandLine, TEXT("AutopilotSkill="), Settings.Skill))
+	{
+		Settings.Skill = FMath::Clamp(Settings.Skill, 0.0f, 1.0f);
+	}
+	// Benchmarks compare runs, so they always play the same one
+	if (FParse::Value(CommandLine, TEXT("AutopilotSeed="), Seed) || FParse::Param(CommandLine, TEXT("RunnerBenchmark")))
+	{
+		bDeterministic = true;
+	}
+	FParse::Value(CommandLine, TEXT("AutopilotDuration="), SessionDuration);
+}
+
+void ARunnerAutopilotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	SessionTime += DeltaSeconds;
+	if (SessionDuration > 0 && SessionTime >= SessionDuration)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ARunnerAutopilotController: session finished after %.0fs and %d runs"), SessionTime, RunCount);
+		SessionDuration = 0;
+		FPlatformMisc::RequestExit(false);
+		return;
+	}
+
+	ARunnerCharacter* MyCharacter = Cast<ARunnerCharacter>(GetPawn());
+	if (!MyCharacter || !MyCharacter->GetSimulation())
+	{
+		return;
+	}
+
+	if (MyCharacter->bIsDead)
+	{
+		HandleDeath(*MyCharacter, DeltaSeconds);
+		return;
+	}
+	if (IsPaused())
+	{
+		return;
+	}
+
+	GatherTrackObjects(*MyCharacter);
+
+	FRunnerSimulation& Simulation = MyCharacter->GetSimulation()->GetSimulation();
+	const FRunnerSimInput Input = RunnerAutopilot::PlanInput(Settings, Simulation.GetConfig(), Simulation.GetState(), TrackObjects, RandomStream);
+	ApplyInput(*MyCharacter, Input);
+}
+
+void ARunnerAutopilotController::GatherTrackObjects(const ARunnerCharacter& MyCharacter)
+{
+	TrackObjects.Reset();
+	if (!MyGameMode || !MyGameMode->RunnerFloorManager)
+	{
+		return;
+	}
+
+	// Objects are placed relative to the player on the simulation track
+	const double TrackPosition = MyCharacter.GetSimulation()->GetState().TrackPosition;
+	const double PlayerX = MyCharacter.GetActorLocation().X;
+
+	for (const AActor* Tile : MyGameMode->RunnerFloorManager->GetTileActors())
+	{
+		const ARunnerFloorActor* Floor = Cast<ARunnerFloorActor>(Tile);
+		if (!Floor)
+		{
+			continue;
+		}
+
+		// Same spawner order as the batch simulator
+		const URunnerSpawnObjectsComponent* Spawners[] = { Floor->MovingObstacleSpawner, Floor->ObstacleSpawner, Floor->PowerupSpawner, Floor->CoinSpawner };
+		const ERunnerTrackObjectKind Kinds[] = { ERunnerTrackObjectKind::Obstacle, ERunnerTrackObjectKind::Obstacle, ERunnerTrackObjectKind::Powerup, ERunnerTrackObjectKind::Coin };
+		for (int32 SpawnerIndex = 0; SpawnerIndex < UE_ARRAY_COUNT(Spawners); ++SpawnerIndex)
+		{
+			if (!Spawners[SpawnerIndex])
+			{
+				continue;
+			}
+
+			for (const UChildActorComponent* Component : Spawners[SpawnerIndex]->GetSpawnedObjects())
+			{
+				const AActor* Object = Component ? Component->GetChildActor() : nullptr;
+				if (!IsValid(Object) || Object->GetActorLocation().X < PlayerX)
+				{
+					continue;
+				}
+
+				const FVector Location = Object->GetActorLocation();
+				FRunnerTrackObject& TrackObject = TrackObjects.AddDefaulted_GetRef();
+				TrackObject.X = TrackPosition + (Location.X - PlayerX);
+				TrackObject.Speed = FMath::Max(-Object->GetVelocity().X, 0.0);
+				TrackObject.Lane = RunnerAutopilot::FindNearestLane(MyCharacter.LaneYOffsets, Location.Y);
+				TrackObject.SpawnerIndex = SpawnerIndex;
+				TrackObject.Kind = Kinds[SpawnerIndex];
+
+				// The spawn point does not move, so an object is noticed or overlooked for its whole approach
+				TrackObject.bNoticed = RunnerAutopilot::IsNoticed(GetTypeHash(Component->GetComponentLocation()), RandomStream.GetInitialSeed(), Settings.Skill);
+			}
+		}
+	}
+}
+
+void ARunnerAutopilotController::ApplyInput(ARunnerCharacter& MyCharacter, const FRunnerSimInput& Input)
+{
+	// Release the jump so the character does not jump again on landing
+	if (MyCharacter.bPressedJump && !Input.bJump)
+	{
+		MyCharacter.StopJumping();
+	}
+
+	// Player input is disabled while sliding
+	if (MyCharacter.bIsSliding)
+	{
+		return;
+	}
+
+	if (Input.LaneOffset < 0)
+	{
+		SwitchLaneLeft();
+	}
+	else if (Input.LaneOffset > 0)
+	{
+		SwitchLaneRight();
+	}
+	if (Input.bJump)
+	{
+		Jump();
+	}
+	if (Input.bSlide)
+	{
+		Slide();
+	}
+}
+
+void ARunnerAutopilotController::HandleDeath(ARunnerCharacter& MyCharacter, float DeltaSeconds)
+{
+	// Wait for the game over pause before resuming, otherwise the pending pause would stop the next run
+	DeadTime += DeltaSeconds;
+	if (DeadTime < ResumeDelay || !IsPaused())
+	{
+		return;
+	}
+
+	const double TrackPosition = MyCharacter.GetSimulation()->GetState().TrackPosition;
+	++RunCount;
+	UE_LOG(LogTemp, Display, TEXT("ARunnerAutopilotController: run %d ended after %.0f at %.0fs into the session"),
+		RunCount, TrackPosition - RunStartPosition, SessionTime);
+
+	DeadTime = 0;
+	RunStartPosition = TrackPosition;
+	MyCharacter.ResumeGameplay();
+}
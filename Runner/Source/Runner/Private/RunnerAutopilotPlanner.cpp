@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerAutopilotPlanner.h"
+
+int32 RunnerAutopilot::FindNearestLane(const TArray<float>& LaneYOffsets, float Y)
+{
+	int32 NearestLane = 0;
+	for (int32 i = 1; i < LaneYOffsets.Num(); ++i)
+	{
+		if (FMath::Abs(LaneYOffsets[i] - Y) < FMath::Abs(LaneYOffsets[NearestLane] - Y))
+		{
+			NearestLane = i;
+		}
+	}
+	return NearestLane;
+}
+
+int32 RunnerAutopilot::GetOccupiedLane(const FRunnerSimState& State)
+{
+	return State.LaneSwitchAlpha < 0.5f ? State.LaneIndex : State.TargetLaneIndex;
+}
+
+bool RunnerAutopilot::IsNoticed(uint32 ObjectKey, int32 Seed, float Skill)
+{
+	return FRandomStream(HashCombine(ObjectKey, GetTypeHash(Seed))).GetFraction() < Skill;
+}
+
+bool RunnerAutopilot::IsLaneBlocked(const TArray<FRunnerTrackObject>& Objects, int32 Lane, double FromX, double ToX)
+{
+	for (const FRunnerTrackObject& Object : Objects)
+	{
+		if (Object.Kind == ERunnerTrackObjectKind::Obstacle && Object.Lane == Lane && Object.X > FromX && Object.X <= ToX)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FRunnerSimInput RunnerAutopilot::PlanInput(const FRunnerAutopilotSettings& Settings, const FRunnerSimConfig& Config, const FRunnerSimState& State,
+	const TArray<FRunnerTrackObject>& Objects, const FRandomStream& RandomStream)
+{
+	FRunnerSimInput Input;
+	const int32 Lane = State.TargetLaneIndex;
+	const int32 LaneNum = Config.LaneYOffsets.Num();
+
+	// Find the closest noticed obstacle in the lane
+	const FRunnerTrackObject* Threat = nullptr;
+	for (const FRunnerTrackObject& Object : Objects)
+	{
+		if (Object.Kind != ERunnerTrackObjectKind::Obstacle || !Object.bNoticed || Object.Lane != Lane || Object.X <= State.TrackPosition)
+		{
+			continue;
+		}
+		const double TimeToContact = (Object.X - State.TrackPosition) / FMath::Max(State.Speed + Object.Speed, 1.0f);
+		if (TimeToContact <= Settings.LookaheadTime && (!Threat || Object.X < Threat->X))
+		{
+			Threat = &Object;
+		}
+	}
+
+	if (Threat)
+	{
+		// Dodge to a free neighbor lane
+		if (!State.IsSwitchingLane())
+		{
+			const double SafeUntil = Threat->X + State.Speed * Config.LaneSwitchDuration;
+			const int32 FirstOffset = RandomStream.GetFraction() < 0.5f ? -1 : 1;
+			for (const int32 Offset : { FirstOffset, -FirstOffset })
+			{
+				const int32 NewLane = Lane + Offset;
+				if (NewLane >= 0 && NewLane < LaneNum && !IsLaneBlocked(Objects, NewLane, State.TrackPosition, SafeUntil))
+				{
+					Input.LaneOffset = Offset;
+					return Input;
+				}
+			}
+		}
+
+		// No free lane, jump or slide right before the obstacle
+		const double Distance = Threat->X - State.TrackPosition;
+		if (Distance <= (State.Speed + Threat->Speed) * Settings.JumpLeadTime && !State.IsAirborne() && !State.IsSliding())
+		{
+			if (RandomStream.GetFraction() < 0.5f)
+			{
+				Input.bJump = true;
+			}
+			else
+			{
+				Input.bSlide = true;
+			}
+		}
+		return Input;
+	}
+
+	// Occasionally steer towards a neighbor lane with more coins
+	if (!State.IsSwitchingLane() && RandomStream.GetFraction() < Settings.Skill * Settings.CoinSeekChance)
+	{
+		const double LookaheadX = State.TrackPosition + State.Speed * Settings.LookaheadTime;
+		int32 CoinsPerLane[3] = { 0, 0, 0 };
+		for (const FRunnerTrackObject& Object : Objects)
+		{
+			if (Object.Kind == ERunnerTrackObjectKind::Coin && Object.X > State.TrackPosition && Object.X <= LookaheadX && FMath::Abs(Object.Lane - Lane) <= 1)
+			{
+				++CoinsPerLane[Object.Lane - Lane + 1];
+			}
+		}
+		for (const int32 Offset : { -1, 1 })
+		{
+			const int32 NewLane = Lane + Offset;
+			if (NewLane >= 0 && NewLane < LaneNum && CoinsPerLane[Offset + 1] > CoinsPerLane[1] && !IsLaneBlocked(Objects, NewLane, State.TrackPosition, LookaheadX))
+			{
+				Input.LaneOffset = Offset;
+				break;
+			}
+		}
+	}
+	return Input;
+}
@@ -0,0 +1,407 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerBatchSimCommandlet.h"
+
+#include "RunnerAutopilotPlanner.h"
+#include "RunnerFloorActor.h"
+#include "RunnerGameMode.h"
+#include "RunnerSimulation.h"
+#include "RunnerSpawnLayout.h"
+#include "RunnerSpawnPolicies.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTileManager.h"
+#include "Async/ParallelFor.h"
+#include "Components/ArrowComponent.h"
+#include "GameMapsSettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace RunnerBatchSim
+{
+	/** Settings of one floor spawner */
+	struct FSpawnerConfig
+	{
+		FString Name;
+		ERunnerTrackObjectKind Kind = ERunnerTrackObjectKind::Coin;
+		FSpawnSettings Settings;
+		bool bUseInterval = false;
+		float MoveSpeed = 0;
+	};
+
+	/** Everything needed to simulate runs of one configuration */
+	struct FRunConfig
+	{
+		FString Label;
+		TArray<FSpawnerConfig> Spawners;
+		FRunnerSimConfig Sim;
+		int32 MaxTiles = 2000;
+		int32 TilesAhead = 3;
+		FRunnerAutopilotSettings Player;
+	};
+
+	struct FRunResult
+	{
+		double Distance = 0;
+		int32 Tiles = 0;
+		int32 Coins = 0;
+		int32 DeathSpawnerIndex = INDEX_NONE;
+	};
+
+	/** Lay out one tile in the same order and with the same rules as ARunnerFloorActor::SpawnAllObjects */
+	void LayOutTile(const FRunConfig& Config, int32 TileIndex, const FRandomStream& LayoutStream, const FRandomStream& PlayerStream, TArray<FRunnerTrackObject>& OutObjects)
+	{
+		const double TileLength = Config.Sim.TileLength;
+		const double TileCenter = (TileIndex + 0.5) * TileLength;
+		const FVector FloorExtent(TileLength * 0.5, 0, 0);
+
+		for (int32 SpawnerIndex = 0; SpawnerIndex < Config.Spawners.Num(); ++SpawnerIndex)
+		{
+			const FSpawnerConfig& Spawner = Config.Spawners[SpawnerIndex];
+			const FSpawnSettings& Settings = Spawner.Settings;
+
+			// The tile manager counts tiles from 1
+			if (Spawner.bUseInterval && !RunnerSpawnLayout::ShouldSpawnOnTile(TileIndex + 1, Settings.SpawnIntervalBase, Settings.SpawnIntervalRandomOffset, LayoutStream))
+			{
+				continue;
+			}
+			if (!Settings.bEnabled || Settings.ActorClasses.Num() == 0)
+			{
+				continue;
+			}
+
+			RunnerSpawnPolicies::LayOutObjects(Settings, FloorExtent, LayoutStream, [&](UClass* ActorClass, const FTransform& SpawnTransform)
+			{
+				FRunnerTrackObject& Object = OutObjects.AddDefaulted_GetRef();
+				Object.X = TileCenter + SpawnTransform.GetLocation().X;
+				Object.Lane = RunnerAutopilot::FindNearestLane(Config.Sim.LaneYOffsets, SpawnTransform.GetLocation().Y);
+				Object.Speed = Spawner.MoveSpeed;
+				Object.SpawnerIndex = SpawnerIndex;
+				Object.Kind = Spawner.Kind;
+				Object.bNoticed = PlayerStream.GetFraction() < Config.Player.Skill;
+			});
+		}
+	}
+
+	/** Simulate one run until death or MaxTiles */
+	FRunResult SimulateRun(const FRunConfig& Config, int32 Seed)
+	{
+		FRunnerSimConfig SimConfig = Config.Sim;
+		SimConfig.Seed = Seed;
+		FRunnerSimulation Simulation(SimConfig);
+		const FRandomStream& LayoutStream = Simulation.GetRandomStream();
+		const FRandomStream PlayerStream(HashCombine(GetTypeHash(Seed), 0x9E3779B9u));
+
+		TArray<FRunnerTrackObject> Objects;
+		FRunResult Result;
+		int32 NextTileIndex = 0;
+		bool bPendingMagnet = false;
+		const float StepSeconds = Simulation.GetStepSeconds();
+
+		while (Simulation.GetState().TileIndex < Config.MaxTiles)
+		{
+			// Lay out the tiles in front of the player
+			while (NextTileIndex * Config.Sim.TileLength < Simulation.GetState().TrackPosition + Config.TilesAhead * Config.Sim.TileLength)
+			{
+				LayOutTile(Config, NextTileIndex++, LayoutStream, PlayerStream, Objects);
+			}
+
+			FRunnerSimInput Input = RunnerAutopilot::PlanInput(Config.Player, Config.Sim, Simulation.GetState(), Objects, PlayerStream);
+			Input.bMagnet = bPendingMagnet;
+			bPendingMagnet = false;
+			Simulation.Step(Input);
+
+			// Resolve the objects the player reached in this step
+			const FRunnerSimState& State = Simulation.GetState();
+			const int32 Lane = RunnerAutopilot::GetOccupiedLane(State);
+			for (int32 i = Objects.Num() - 1; i >= 0; --i)
+			{
+				FRunnerTrackObject& Object = Objects[i];
+				Object.X -= Object.Speed * StepSeconds;
+				if (Object.X > State.TrackPosition)
+				{
+					continue;
+				}
+
+				switch (Object.Kind)
+				{
+				case ERunnerTrackObjectKind::Coin:
+					if (Object.Lane == Lane || State.IsMagnetActive())
+					{
+						++Result.Coins;
+					}
+					break;
+				case ERunnerTrackObjectKind::Powerup:
+					bPendingMagnet |= Object.Lane == Lane;
+					break;
+				case ERunnerTrackObjectKind::Obstacle:
+					if (Object.Lane == Lane && !State.IsAirborne() && !State.IsSliding())
+					{
+						Result.DeathSpawnerIndex = Object.SpawnerIndex;
+					}
+					break;
+				}
+				Objects.RemoveAtSwap(i);
+			}
+
+			if (Result.DeathSpawnerIndex != INDEX_NONE)
+			{
+				break;
+			}
+		}
+
+		Result.Distance = Simulation.GetState().TrackPosition;
+		Result.Tiles = Simulation.GetState().TileIndex;
+		return Result;
+	}
+
+	template<typename T>
+	T Percentile(const TArray<T>& SortedValues, float Percent)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return T();
+		}
+		const int32 Index = FMath::Clamp(FMath::FloorToInt32(Percent * (SortedValues.Num() - 1)), 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+
+	/** Load the floor tile defaults, from -TileClass or from the tile manager of the default game mode */
+	const ARunnerFloorActor* LoadFloorDefaults(const FString& Params)
+	{
+		FString TileClassPath;
+		if (!FParse::Value(*Params, TEXT("TileClass="), TileClassPath))
+		{
+			const FString GameModePath = UGameMapsSettings::GetGlobalDefaultGameMode();
+			if (const UClass* GameModeClass = LoadObject<UClass>(nullptr, *GameModePath))
+			{
+				const ARunnerGameMode* GameModeDefaults = Cast<ARunnerGameMode>(GameModeClass->GetDefaultObject());
+				if (GameModeDefaults && GameModeDefaults->RunnerFloorManager && GameModeDefaults->RunnerFloorManager->TileClass)
+				{
+					return Cast<ARunnerFloorActor>(GameModeDefaults->RunnerFloorManager->TileClass->GetDefaultObject());
+				}
+			}
+			UE_LOG(LogTemp, Warning, TEXT("RunnerBatchSim: no floor tile class found in %s, using native defaults"), *GameModePath);
+			return GetDefault<ARunnerFloorActor>();
+		}
+
+		const UClass* TileClass = LoadObject<UClass>(nullptr, *TileClassPath);
+		if (!TileClass || !TileClass->IsChildOf(ARunnerFloorActor::StaticClass()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("RunnerBatchSim: %s is not a floor tile class"), *TileClassPath);
+			return nullptr;
+		}
+		return TileClass->GetDefaultObject<ARunnerFloorActor>();
+	}
+
+	/** Build the base configuration from the floor tile defaults */
+	FRunConfig MakeBaseConfig(const ARunnerFloorActor& FloorDefaults, const FString& Params)
+	{
+		FRunConfig Config;
+		Config.Label = TEXT("Base");
+
+		auto AddSpawner = [&Config](const FString& Name, const URunnerSpawnObjectsComponent* Spawner, ERunnerTrackObjectKind Kind, bool bUseInterval, float MoveSpeed)
+		{
+			if (Spawner)
+			{
+				FSpawnerConfig& SpawnerConfig = Config.Spawners.AddDefaulted_GetRef();
+				SpawnerConfig.Name = Name;
+				SpawnerConfig.Kind = Kind;
+				SpawnerConfig.Settings = Spawner->GetSpawnSettings();
+				SpawnerConfig.bUseInterval = bUseInterval;
+				SpawnerConfig.MoveSpeed = MoveSpeed;
+			}
+		};
+
+		float MovingObstacleSpeed = 300;
+		FParse::Value(*Params, TEXT("MovingObstacleSpeed="), MovingObstacleSpeed);
+
+		// Same order as ARunnerFloorActor::SpawnAllObjects
+		AddSpawner(TEXT("MovingObstacle"), FloorDefaults.MovingObstacleSpawner, ERunnerTrackObjectKind::Obstacle, true, MovingObstacleSpeed);
+		AddSpawner(TEXT("Obstacle"), FloorDefaults.ObstacleSpawner, ERunnerTrackObjectKind::Obstacle, false, 0);
+		AddSpawner(TEXT("Powerup"), FloorDefaults.PowerupSpawner, ERunnerTrackObjectKind::Powerup, true, 0);
+		AddSpawner(TEXT("Coin"), FloorDefaults.CoinSpawner, ERunnerTrackObjectKind::Coin, false, 0);
+
+		for (const FSpawnerConfig& Spawner : Config.Spawners)
+		{
+			if (Spawner.Settings.ActorClasses.Num() == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("RunnerBatchSim: %s has no actor classes and spawns nothing"), *Spawner.Name);
+			}
+		}
+
+		// The next tile is attached at the arrow, so its offset is the tile length
+		Config.Sim.TileLength = FloorDefaults.AttachpointArrow ? FloorDefaults.AttachpointArrow->GetRelativeLocation().X : 0;
+		FParse::Value(*Params, TEXT("TileLength="), Config.Sim.TileLength);
+		if (Config.Sim.TileLength <= 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RunnerBatchSim: tile length unknown, using 1000"));
+			Config.Sim.TileLength = 1000;
+		}
+
+		Config.Sim.SpeedIncrement = FloorDefaults.SpeedIncrement;
+		Config.Sim.MaxSpeed = FloorDefaults.MaxSpeed;
+		FParse::Value(*Params, TEXT("StartSpeed="), Config.Sim.StartSpeed);
+		FParse::Value(*Params, TEXT("MaxTiles="), Config.MaxTiles);
+		FParse::Value(*Params, TEXT("Skill="), Config.Player.Skill);
+		Config.Player.Skill = FMath::Clamp(Config.Player.Skill, 0.0f, 1.0f);
+		return Config;
+	}
+
+	/** Set a spawn settings field by name */
+	bool SetSpawnField(FSpawnSettings& Settings, const FString& Field, int32 Value)
+	{
+		if (Field == TEXT("ActorNum")) { Settings.ActorNum = Value; return true; }
+		if (Field == TEXT("PointsPerLane")) { Settings.PointsPerLane = Value; return true; }
+		if (Field == TEXT("SpawnIntervalBase")) { Settings.SpawnIntervalBase = Value; return true; }
+		if (Field == TEXT("SpawnIntervalRandomOffset")) { Settings.SpawnIntervalRandomOffset = Value; return true; }
+		return false;
+	}
+
+	/** Expand -Sweep=Spawner.Field:V1,V2;... into one configuration per value */
+	TArray<FRunConfig> MakeSweepConfigs(const FRunConfig& BaseConfig, const FString& Params)
+	{
+		TArray<FRunConfig> Configs;
+		Configs.Add(BaseConfig);
+
+		FString Sweep;
+		if (!FParse::Value(*Params, TEXT("Sweep="), Sweep, false))
+		{
+			return Configs;
+		}
+
+		TArray<FString> Entries;
+		Sweep.ParseIntoArray(Entries, TEXT(";"));
+		for (const FString& Entry : Entries)
+		{
+			FString Target, ValueList, SpawnerName, Field;
+			if (!Entry.Split(TEXT(":"), &Target, &ValueList) || !Target.Split(TEXT("."), &SpawnerName, &Field))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("RunnerBatchSim: ignoring sweep entry %s"), *Entry);
+				continue;
+			}
+
+			TArray<FString> Values;
+			ValueList.ParseIntoArray(Values, TEXT(","));
+			for (const FString& Value : Values)
+			{
+				FRunConfig Config = BaseConfig;
+				Config.Label = FString::Printf(TEXT("%s=%s"), *Target, *Value);
+				FSpawnerConfig* Spawner = Config.Spawners.FindByPredicate([&SpawnerName](const FSpawnerConfig& Item) { return Item.Name == SpawnerName; });
+				if (Spawner && SetSpawnField(Spawner->Settings, Field, FCString::Atoi(*Value)))
+				{
+					Configs.Add(MoveTemp(Config));
+				}
+				else
+				{
+					UE_LOG(LogTemp, Warning, TEXT("RunnerBatchSim: unknown sweep target %s"), *Target);
+					break;
+				}
+			}
+		}
+		return Configs;
+	}
+}
+
+URunnerBatchSimCommandlet::URunnerBatchSimCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 URunnerBatchSimCommandlet::Main(const FString& Params)
+{
+	using namespace RunnerBatchSim;
+
+	const ARunnerFloorActor* FloorDefaults = LoadFloorDefaults(Params);
+	if (!FloorDefaults)
+	{
+		return 1;
+	}
+
+	int32 NumRuns = 2000;
+	int32 BaseSeed = 1;
+	FParse::Value(*Params, TEXT("Runs="), NumRuns);
+	FParse::Value(*Params, TEXT("Seed="), BaseSeed);
+	NumRuns = FMath::Max(NumRuns, 1);
+
+	const TArray<FRunConfig> Configs = MakeSweepConfigs(MakeBaseConfig(*FloorDefaults, Params), Params);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("RunnerBatchSim.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	// Header, one death column per spawner
+	FString Csv = TEXT("Config,Runs,Survived,DistanceMean,DistanceP10,DistanceP50,DistanceP90,CoinsMean,CoinsP10,CoinsP50,CoinsP90,TilesP50");
+	for (const FSpawnerConfig& Spawner : Configs[0].Spawners)
+	{
+		Csv += FString::Printf(TEXT(",Deaths_%s"), *Spawner.Name);
+	}
+	Csv += LINE_TERMINATOR;
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FRunResult> Results;
+	for (const FRunConfig& Config : Configs)
+	{
+		// Every run is independent, the same seeds are used for every configuration
+		Results.SetNum(NumRuns);
+		ParallelFor(NumRuns, [&Config, &Results, BaseSeed](int32 RunIndex)
+		{
+			Results[RunIndex] = SimulateRun(Config, BaseSeed + RunIndex);
+		});
+
+		TArray<double> Distances;
+		TArray<int32> Coins;
+		TArray<int32> Tiles;
+		TArray<int32> Deaths;
+		Deaths.SetNumZeroed(Config.Spawners.Num());
+		int32 Survived = 0;
+		double DistanceSum = 0;
+		int64 CoinSum = 0;
+		for (const FRunResult& Result : Results)
+		{
+			Distances.Add(Result.Distance);
+			Coins.Add(Result.Coins);
+			Tiles.Add(Result.Tiles);
+			DistanceSum += Result.Distance;
+			CoinSum += Result.Coins;
+			if (Deaths.IsValidIndex(Result.DeathSpawnerIndex))
+			{
+				++Deaths[Result.DeathSpawnerIndex];
+			}
+			else
+			{
+				++Survived;
+			}
+		}
+		Distances.Sort();
+		Coins.Sort();
+		Tiles.Sort();
+
+		UE_LOG(LogTemp, Display, TEXT("RunnerBatchSim [%s]: distance p10/p50/p90 %.0f/%.0f/%.0f, coins p50 %d, survived %d/%d"),
+			*Config.Label, Percentile(Distances, 0.1f), Percentile(Distances, 0.5f), Percentile(Distances, 0.9f),
+			Percentile(Coins, 0.5f), Survived, NumRuns);
+
+		Csv += FString::Printf(TEXT("%s,%d,%d,%.1f,%.1f,%.1f,%.1f,%.2f,%d,%d,%d,%d"),
+			*Config.Label, NumRuns, Survived,
+			DistanceSum / NumRuns, Percentile(Distances, 0.1f), Percentile(Distances, 0.5f), Percentile(Distances, 0.9f),
+			static_cast<double>(CoinSum) / NumRuns, Percentile(Coins, 0.1f), Percentile(Coins, 0.5f), Percentile(Coins, 0.9f),
+			Percentile(Tiles, 0.5f));
+		for (const int32 DeathCount : Deaths)
+		{
+			Csv += FString::Printf(TEXT(",%d"), DeathCount);
+		}
+		Csv += LINE_TERMINATOR;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("RunnerBatchSim: %d configurations x %d runs in %.2fs"), Configs.Num(), NumRuns, FPlatformTime::Seconds() - StartTime);
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("RunnerBatchSim: failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("RunnerBatchSim: results written to %s"), *OutputPath);
+	return 0;
+}
@@ -0,0 +1,352 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerBenchmarkSubsystem.h"
+#include "RunnerCharacter.h"
+#include "RunnerGameMode.h"
+#include "RunnerGCManager.h"
+#include "RunnerPerfBaselines.h"
+#include "RunnerProfiling.h"
+#include "RunnerSimulationComponent.h"
+
+#include "Dom/JsonObject.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectGlobals.h"
+
+bool URunnerBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("RunnerBenchmark")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool URunnerBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("BenchmarkDistance="), TargetDistance);
+	FParse::Value(CommandLine, TEXT("BenchmarkTimeout="), TimeoutSeconds);
+	if (!FParse::Value(CommandLine, TEXT("BenchmarkReport="), ReportPath))
+	{
+		ReportPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / FString::Printf(TEXT("RunnerBenchmark-%s.json"), *FDateTime::Now().ToString());
+	}
+
+	// Reserve for an hour at 60 fps so sampling does not allocate during the run
+	FrameTimes.Reserve(60 * 60 * 60);
+	GameThreadTimes.Reserve(60 * 60 * 60);
+	GCPauses.Reserve(1024);
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &URunnerBenchmarkSubsystem::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &URunnerBenchmarkSubsystem::OnPostGarbageCollect);
+}
+
+void URunnerBenchmarkSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	if (bStarted && !bFinished)
+	{
+		Finish(false, TEXT("World was torn down before the benchmark finished"), 0, 0);
+	}
+	FRunnerCostCounter::SetRecordSamples(false);
+
+	Super::Deinitialize();
+}
+
+TStatId URunnerBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void URunnerBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	// Wait for the runner and its simulation, the benchmark map may still be loading
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (!MyCharacter || !MyCharacter->GetSimulation())
+	{
+		return;
+	}
+	const FRunnerSimState& State = MyCharacter->GetSimulation()->GetState();
+
+	if (!bStarted)
+	{
+		bStarted = true;
+		StartTime = FPlatformTime::Seconds();
+		StartPosition = State.TrackPosition;
+		StartTileIndex = State.TileIndex;
+		FRunnerCostCounter::ResetAll();
+		FRunnerCostCounter::SetRecordSamples(true);
+		UE_LOG(LogTemp, Display, TEXT("URunnerBenchmarkSubsystem: started, running %.0f"), TargetDistance);
+		return;
+	}
+
+	FrameTimes.Add(DeltaTime * 1000.0f);
+	GameThreadTimes.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	if (MyCharacter->bIsDead && !bWasDead)
+	{
+		++Deaths;
+	}
+	bWasDead = MyCharacter->bIsDead;
+
+	// Object counts need a full actor iteration, sample them at a low rate
+	if (GFrameCounter % 30 == 0)
+	{
+		int32 Actors = 0;
+		int32 Components = 0;
+		SampleObjectCounts(Actors, Components);
+		SampleMemory();
+	}
+
+	const int32 Tiles = State.TileIndex - StartTileIndex;
+	if (Tiles >= NextMilestoneTile)
+	{
+		int32 Actors = 0;
+		int32 Components = 0;
+		SampleObjectCounts(Actors, Components);
+		CountsAtTile.Add(FIntVector(NextMilestoneTile, Actors, Components));
+		if (RunnerLLM::IsEnabled())
+		{
+			for (const FName Tag : RunnerLLM::GetAllTags())
+			{
+				TagMemoryAtTile.Add(RunnerLLM::GetTagAmount(Tag));
+			}
+		}
+		NextMilestoneTile += 100;
+	}
+
+	const double Distance = State.TrackPosition - StartPosition;
+	switch (GetResult(Distance, FPlatformTime::Seconds() - StartTime, TargetDistance, TimeoutSeconds))
+	{
+	case ERunnerBenchmarkResult::Succeeded:
+		Finish(true, TEXT("Target distance reached"), Distance, Tiles);
+		break;
+	case ERunnerBenchmarkResult::TimedOut:
+		Finish(false, TEXT("Timed out before the target distance"), Distance, Tiles);
+		break;
+	default:
+		break;
+	}
+}
+
+ERunnerBenchmarkResult URunnerBenchmarkSubsystem::GetResult(double Distance, double ElapsedSeconds, double TargetDistance, double TimeoutSeconds)
+{
+	// Reaching the distance on the frame of the timeout still counts
+	if (Distance >= TargetDistance)
+	{
+		return ERunnerBenchmarkResult::Succeeded;
+	}
+	return ElapsedSeconds >= TimeoutSeconds ? ERunnerBenchmarkResult::TimedOut : ERunnerBenchmarkResult::Running;
+}
+
+void URunnerBenchmarkSubsystem::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void URunnerBenchmarkSubsystem::OnPostGarbageCollect()
+{
+	if (bStarted && !bFinished && GCStartTime > 0)
+	{
+		GCPauses.Add((FPlatformTime::Seconds() - GCStartTime) * 1000.0);
+	}
+	GCStartTime = 0;
+}
+
+void URunnerBenchmarkSubsystem::SampleObjectCounts(int32& OutActors, int32& OutComponents)
+{
+	OutActors = 0;
+	OutComponents = 0;
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		++OutActors;
+		OutComponents += It->GetComponents().Num();
+	}
+	PeakActors = FMath::Max(PeakActors, OutActors);
+	PeakComponents = FMath::Max(PeakComponents, OutComponents);
+}
+
+void URunnerBenchmarkSubsystem::SampleMemory()
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, MemoryStats.UsedPhysical);
+	PeakUsedVirtual = FMath::Max<uint64>(PeakUsedVirtual, MemoryStats.UsedVirtual);
+
+	if (RunnerLLM::IsEnabled())
+	{
+		const TArray<FName>& Tags = RunnerLLM::GetAllTags();
+		PeakTagMemory.SetNumZeroed(Tags.Num());
+		for (int32 Index = 0; Index < Tags.Num(); ++Index)
+		{
+			PeakTagMemory[Index] = FMath::Max(PeakTagMemory[Index], RunnerLLM::GetTagAmount(Tags[Index]));
+		}
+	}
+}
+
+TSharedRef<FJsonObject> URunnerBenchmarkSubsystem::MakeDistribution(TArray<float> Samples)
+{
+	TSharedRef<FJsonObject> Distribution = MakeShared<FJsonObject>();
+	Distribution->SetNumberField(TEXT("Count"), Samples.Num());
+	if (Samples.Num() == 0)
+	{
+		return Distribution;
+	}
+
+	Samples.Sort();
+	double Sum = 0;
+	for (const float Sample : Samples)
+	{
+		Sum += Sample;
+	}
+	auto Percentile = [&Samples](float Percent)
+	{
+		return Samples[FMath::Clamp(FMath::CeilToInt32(Percent * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	};
+
+	Distribution->SetNumberField(TEXT("Mean"), Sum / Samples.Num());
+	Distribution->SetNumberField(TEXT("P50"), Percentile(0.50f));
+	Distribution->SetNumberField(TEXT("P95"), Percentile(0.95f));
+	Distribution->SetNumberField(TEXT("P99"), Percentile(0.99f));
+	Distribution->SetNumberField(TEXT("Max"), Samples.Last());
+	return Distribution;
+}
+
+void URunnerBenchmarkSubsystem::Finish(bool bSucceeded, const FString& Reason, double Distance, int32 Tiles)
+{
+	bFinished = true;
+
+	int32 Actors = 0;
+	int32 Components = 0;
+	SampleObjectCounts(Actors, Components);
+	SampleMemory();
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("Version"), 1);
+	Report->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	Report->SetStringField(TEXT("Build"), FApp::GetBuildVersion());
+	Report->SetNumberField(TEXT("Changelist"), FEngineVersion::Current().GetChangelist());
+	Report->SetStringField(TEXT("CommandLine"), FCommandLine::Get());
+	Report->SetBoolField(TEXT("Succeeded"), bSucceeded);
+	Report->SetStringField(TEXT("Reason"), Reason);
+	Report->SetNumberField(TEXT("Distance"), Distance);
+	Report->SetNumberField(TEXT("Tiles"), Tiles);
+	Report->SetNumberField(TEXT("DurationSeconds"), FPlatformTime::Seconds() - StartTime);
+	Report->SetNumberField(TEXT("Frames"), FrameTimes.Num());
+	Report->SetNumberField(TEXT("Deaths"), Deaths);
+
+	// Millisecond distributions
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	Metrics->SetObjectField(TEXT("FrameTimeMs"), MakeDistribution(FrameTimes));
+	Metrics->SetObjectField(TEXT("GameThreadMs"), MakeDistribution(GameThreadTimes));
+	Metrics->SetObjectField(TEXT("GCPauseMs"), MakeDistribution(GCPauses));
+	const ARunnerGameMode* MyGameMode = Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode());
+	if (MyGameMode && MyGameMode->RunnerGCManager)
+	{
+		// Collections per run state since the map was loaded
+		TSharedRef<FJsonObject> StatePauses = MakeShared<FJsonObject>();
+		const UEnum* StateEnum = StaticEnum<ERunnerRunState>();
+		for (int32 Index = 0; Index < static_cast<int32>(ERunnerRunState::Num); ++Index)
+		{
+			const FRunnerGCStateStats& Stats = MyGameMode->RunnerGCManager->GetStateStats(static_cast<ERunnerRunState>(Index));
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetNumberField(TEXT("Count"), Stats.Count);
+			Entry->SetNumberField(TEXT("TotalMs"), Stats.TotalMs);
+			Entry->SetNumberField(TEXT("MaxMs"), Stats.MaxMs);
+			StatePauses->SetObjectField(StateEnum->GetNameStringByIndex(Index), Entry);
+		}
+		Metrics->SetObjectField(TEXT("GCPauseMsByState"), StatePauses);
+	}
+	for (const FRunnerCostCounter* Counter : FRunnerCostCounter::GetAll())
+	{
+		Metrics->SetObjectField(FString::Printf(TEXT("%sMs"), Counter->GetName()), MakeDistribution(Counter->GetSamples()));
+	}
+
+	// Memory of the runner LLM tags, peak and every 100 tiles, when run with -llm
+	if (PeakTagMemory.Num() > 0)
+	{
+		const TArray<FName>& Tags = RunnerLLM::GetAllTags();
+		TSharedRef<FJsonObject> PeakMemory = MakeShared<FJsonObject>();
+		TSharedRef<FJsonObject> MemoryAtTile = MakeShared<FJsonObject>();
+		const int32 Samples = TagMemoryAtTile.Num() / Tags.Num();
+		for (int32 Index = 0; Index < Tags.Num(); ++Index)
+		{
+			PeakMemory->SetNumberField(RunnerLLM::GetReportName(Tags[Index]), PeakTagMemory[Index] / (1024.0 * 1024.0));
+
+			TArray<TSharedPtr<FJsonValue>> Values;
+			for (int32 Sample = 0; Sample < Samples; ++Sample)
+			{
+				Values.Add(MakeShared<FJsonValueNumber>(TagMemoryAtTile[Sample * Tags.Num() + Index] / (1024.0 * 1024.0)));
+			}
+			MemoryAtTile->SetArrayField(RunnerLLM::GetReportName(Tags[Index]), Values);
+		}
+		Metrics->SetObjectField(TEXT("MemoryMB"), PeakMemory);
+		Report->SetObjectField(TEXT("MemoryMBAtTile"), MemoryAtTile);
+	}
+	Report->SetObjectField(TEXT("Metrics"), Metrics);
+	Report->SetNumberField(TEXT("SpawnMsPerTile"), RunnerCost::SpawnObjects.GetTotalSeconds() * 1000.0 / FMath::Max(RunnerCost::AddTile.GetCallCount(), 1));
+
+	Report->SetNumberField(TEXT("PeakActors"), PeakActors);
+	Report->SetNumberField(TEXT("PeakComponents"), PeakComponents);
+	Report->SetNumberField(TEXT("FinalActors"), Actors);
+	Report->SetNumberField(TEXT("FinalComponents"), Components);
+	Report->SetNumberField(TEXT("PeakUsedPhysicalMB"), PeakUsedPhysical / (1024.0 * 1024.0));
+	Report->SetNumberField(TEXT("PeakUsedVirtualMB"), PeakUsedVirtual / (1024.0 * 1024.0));
+
+	TArray<TSharedPtr<FJsonValue>> Counts;
+	for (const FIntVector& Count : CountsAtTile)
+	{
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("Tile"), Count.X);
+		Entry->SetNumberField(TEXT("Actors"), Count.Y);
+		Entry->SetNumberField(TEXT("Components"), Count.Z);
+		Counts.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+	Report->SetArrayField(TEXT("CountsAtTile"), Counts);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(Json, *ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("URunnerBenchmarkSubsystem: failed to write %s"), *ReportPath);
+		bSucceeded = false;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerBenchmarkSubsystem: %s (%s), report written to %s"),
+		bSucceeded ? TEXT("succeeded") : TEXT("failed"), *Reason, *ReportPath);
+
+	// Gate against a stored baseline
+	FString BaselineName;
+	if (bSucceeded && FParse::Value(FCommandLine::Get(), TEXT("BenchmarkBaseline="), BaselineName))
+	{
+		FRunnerPerfBaselines Baselines;
+		TArray<FRunnerPerfMetricResult> Results;
+		bSucceeded = Baselines.Load(FRunnerPerfBaselines::GetDefaultPath())
+			&& Baselines.Compare(BaselineName, *Report, Results)
+			&& FRunnerPerfBaselines::LogResults(BaselineName, Results);
+	}
+
+	FRunnerCostCounter::SetRecordSamples(false);
+	FPlatformMisc::RequestExitWithStatus(false, bSucceeded ? 0 : 1);
+}
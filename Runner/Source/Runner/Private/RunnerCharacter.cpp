@@ -2,11 +2,17 @@
 
 #include "RunnerCharacter.h"
 
+#include "RunnerFloorActor.h"
 #include "RunnerGameInstance.h"
 #include "RunnerGameMode.h"
 #include "RunnerScoreManager.h"
+#include "RunnerSimulationComponent.h"
+#include "RunnerStressSubsystem.h"
+#include "RunnerTileManager.h"
+#include "RunnerWidgetManager.h"
 #include "Engine/LocalPlayer.h"
 #include "Camera/CameraComponent.h"
+#include "Components/ArrowComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
@@ -20,6 +26,15 @@
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
+/** Widget layers, higher layers are drawn on top */
+namespace RunnerWidgetLayer
+{
+	constexpr int32 GamePlay = 0;
+	constexpr int32 GameOver = 10;
+	constexpr int32 ResumePopup = 20;
+	constexpr int32 PauseMenu = 30;
+}
+
 ARunnerCharacter::ARunnerCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -55,6 +70,9 @@ ARunnerCharacter::ARunnerCharacter()
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+
+	// Create the gameplay simulation
+	Simulation = CreateDefaultSubobject<URunnerSimulationComponent>(TEXT("Simulation"));
 }
 
 void ARunnerCharacter::Tick(float DeltaTime)
@@ -64,11 +82,8 @@ void ARunnerCharacter::Tick(float DeltaTime)
 	// Make player move forward infinitely
 	AddMovementInput(GetActorForwardVector());
 
-	// Update the lane switch timeline, which controls the player's movement between lanes over time
-	if (LaneSwitchTimeline.IsPlaying())
-	{
-		LaneSwitchTimeline.TickTimeline(DeltaTime);
-	}
+	// Advance the gameplay simulation, which controls speed, tile passes, lane switches and effect timers
+	TickSimulation(DeltaTime);
 }
 
 void ARunnerCharacter::BeginPlay()
@@ -79,17 +94,99 @@ void ARunnerCharacter::BeginPlay()
 	MyGameMode = Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode());
 	MyGameInstance = Cast<URunnerGameInstance>(GetGameInstance());
 
-	// Add game play widget
+	// Add game play widget and create the other widgets up front so none is created mid-run
 	if (GamePlayWidgetClass)
 	{
-		AddWidgetToViewPort(GamePlayWidgetClass, false);
+		AddWidgetToViewPort(GamePlayWidgetClass, false, RunnerWidgetLayer::GamePlay);
+	}
+	if (MyGameMode && MyGameMode->RunnerWidgetManager)
+	{
+		MyGameMode->RunnerWidgetManager->PrecreateWidget(GameOverWidgetClass);
+		MyGameMode->RunnerWidgetManager->PrecreateWidget(PauseMenuWidgetClass);
+		MyGameMode->RunnerWidgetManager->PrecreateWidget(ResumePopupWidgetClass);
 	}
 
 	// Spawn character
 	SpawnSelectedCharacter();
 
-	// Initialize the land switch timeline
-	InitTimelineForLaneSwitch();
+	// Initialize the gameplay simulation
+	InitSimulation();
+}
+
+void ARunnerCharacter::InitSimulation()
+{
+	FRunnerSimConfig& Config = Simulation->Config;
+	Config.StartSpeed = GetCharacterMovement()->MaxWalkSpeed;
+	Config.LaneYOffsets = LaneYOffsets;
+	Config.StartLaneIndex = LaneIndex;
+	Config.LaneSwitchDuration = LaneSwitchDuration;
+	Config.SlideDuration = SlidingDuration;
+	Config.MagnetDuration = MagnetDuration;
+
+	// Derive passed tiles from the track position, the next tile is attached at the arrow so its offset is the tile length
+	const ARunnerFloorActor* FloorDefaults = nullptr;
+	if (MyGameMode && MyGameMode->RunnerFloorManager && MyGameMode->RunnerFloorManager->TileClass)
+	{
+		FloorDefaults = Cast<ARunnerFloorActor>(MyGameMode->RunnerFloorManager->TileClass->GetDefaultObject());
+	}
+	if (FloorDefaults && FloorDefaults->AttachpointArrow)
+	{
+		Config.TileLength = FloorDefaults->AttachpointArrow->GetRelativeLocation().X;
+		Config.SpeedIncrement = FloorDefaults->SpeedIncrement;
+		Config.MaxSpeed = FloorDefaults->MaxSpeed;
+		TileScoreIncrement = FloorDefaults->ScoreIncrement;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ARunnerCharacter: floor tile class unknown, passed tiles come from the floor overlaps"));
+		Config.TileLength = 0;
+	}
+
+#if !UE_BUILD_SHIPPING
+	if (const URunnerStressSubsystem* Stress = GetWorld()->GetSubsystem<URunnerStressSubsystem>())
+	{
+		Stress->ApplyToSimulation(Config);
+	}
+#endif
+
+	Simulation->ResetSimulation();
+}
+
+void ARunnerCharacter::TickSimulation(float DeltaTime)
+{
+	const FRunnerSimEvents Events = Simulation->Advance(DeltaTime);
+	const FRunnerSimState& State = Simulation->GetState();
+
+	// Apply speed and lateral position
+	GetCharacterMovement()->MaxWalkSpeed = Simulation->GetInterpolatedSpeed();
+	if (State.IsSwitchingLane() || Events.bLaneSwitchFinished)
+	{
+		FVector NewLocation = GetActorLocation();
+		NewLocation.Y = Simulation->GetInterpolatedLateralPosition(LaneSwitchCurve);
+		SetActorLocation(NewLocation);
+	}
+
+	// Mirror effect timers for Blueprints
+	MagnetTimer = State.MagnetTimeRemaining;
+
+	// Tiles passed in the simulation score independent of the frame rate
+	if (Events.TilesPassed > 0 && Simulation->Config.TileLength > 0 && MyGameMode && MyGameMode->RunnerScoreManager)
+	{
+		MyGameMode->RunnerScoreManager->AddScore(Events.TilesPassed * TileScoreIncrement);
+	}
+
+	if (Events.bLaneSwitchFinished)
+	{
+		OnLaneSwitchFinished();
+	}
+	if (Events.bSlideEnded)
+	{
+		EndSlide();
+	}
+	if (Events.bMagnetEnded)
+	{
+		MagnetPowerupEnd();
+	}
 }
 
 void ARunnerCharacter::StartSlide()
@@ -110,13 +207,8 @@ void ARunnerCharacter::StartSlide()
 	}
 	MyCapsuleComponent->SetCollisionResponseToChannel(ECC_Destructible, ECollisionResponse::ECR_Ignore);
 
-	// Use Timer to end sliding
-	GetWorld()->GetTimerManager().SetTimer(
-		SlidingTimerHandle,
-		this,
-		&ARunnerCharacter::EndSlide,
-		SlidingDuration,
-		false);
+	// The simulation ends sliding
+	Simulation->QueueSlide();
 }
 
 void ARunnerCharacter::EndSlide()
@@ -149,55 +241,14 @@ void ARunnerCharacter::SwitchLane(int32 LaneOffset)
 	
 	bIsSwitchingLane = true;
 
-	// Get current location
-	FVector CurrentLocation = GetActorLocation();
-	
-	// Adjust the target X position based on the player's speed and switch duration
-	float TargetX = CurrentLocation.X + (GetCharacterMovement()->Velocity.X * LaneSwitchDuration);
-
-	// Set target Y position based on lane offset position
-	float TargetY = LaneYOffsets[NewIndex];
-
-	// Set target location
-	FVector TargetLocation = FVector(TargetX , TargetY, GetActorLocation().Z);
-	LaneSwitchData = FLaneSwitchData(CurrentLocation, TargetLocation, NewIndex);
-
-	// Execute timeline for lane switch
-	if (LaneSwitchCurve)
-	{
-		LaneSwitchTimeline.SetPlayRate(1.0f / LaneSwitchDuration);
-		LaneSwitchTimeline.PlayFromStart();
-	}
-}
-
-void ARunnerCharacter::InitTimelineForLaneSwitch()
-{
-	if (LaneSwitchCurve)
-	{
-		FOnTimelineFloat TimelineProgress;
-		TimelineProgress.BindUFunction(this, FName("OnLaneSwitchProgress"));
-		LaneSwitchTimeline.AddInterpFloat(LaneSwitchCurve, TimelineProgress);
-
-		FOnTimelineEvent TimelineFinished;
-		TimelineFinished.BindUFunction(this, FName("OnLaneSwitchFinished"));
-		LaneSwitchTimeline.SetTimelineFinishedFunc(TimelineFinished);
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("LaneSwitchCurve is NULL"))
-	}
-}
-
-void ARunnerCharacter::OnLaneSwitchProgress(float Value)
-{
-	FVector NewLocation = FMath::Lerp(LaneSwitchData.StartLocation, LaneSwitchData.EndLocation, Value);
-	SetActorLocation(NewLocation);
+	// The simulation moves the player between lanes
+	Simulation->QueueLaneSwitch(LaneOffset);
 }
 
 void ARunnerCharacter::OnLaneSwitchFinished()
 {
 	bIsSwitchingLane = false;
-	LaneIndex = LaneSwitchData.NewLaneIndex;
+	LaneIndex = Simulation->GetState().LaneIndex;
 }
 
 void ARunnerCharacter::ResumeGameplay()
@@ -206,9 +257,25 @@ void ARunnerCharacter::ResumeGameplay()
 
 	RespawnPlayerAfterDeath(0);
 
+	// Continue the simulation in the lane closest to the respawn location
+	int32 RespawnLaneIndex = 0;
+	for (int32 i = 1; i < LaneYOffsets.Num(); ++i)
+	{
+		if (FMath::Abs(LaneYOffsets[i]) < FMath::Abs(LaneYOffsets[RespawnLaneIndex]))
+		{
+			RespawnLaneIndex = i;
+		}
+	}
+	LaneIndex = RespawnLaneIndex;
+	bIsSwitchingLane = false;
+	Simulation->SetLane(RespawnLaneIndex);
+	Simulation->SetDead(false);
+
 	TogglePlayerInput(true);
 
-	AddWidgetToViewPort(GamePlayWidgetClass, false);
+	RemoveWidgetFromViewPort(GameOverWidgetClass);
+	RemoveWidgetFromViewPort(ResumePopupWidgetClass);
+	AddWidgetToViewPort(GamePlayWidgetClass, false, RunnerWidgetLayer::GamePlay);
 
 	UGameplayStatics::SetGamePaused(GetWorld(), false);
 }
@@ -217,12 +284,14 @@ void ARunnerCharacter::PlayerDeath()
 {
 	bIsDead = true;
 
+	Simulation->SetDead(true);
+
 	TogglePlayerInput(false);
 
 	// Show widget & enable mouse
 	if (GameOverWidgetClass)
 	{
-		AddWidgetToViewPort(GameOverWidgetClass, true);
+		AddWidgetToViewPort(GameOverWidgetClass, true, RunnerWidgetLayer::GameOver, true);
 	}
 	
 	// Save current data
@@ -265,25 +334,21 @@ void ARunnerCharacter::SpawnObstacleDestroyer(const FTransform& InTransform) con
 
 void ARunnerCharacter::TogglePauseMenu()
 {
-	if (!PauseMenuWidgetClass)
+	if (!PauseMenuWidgetClass || !MyGameMode || !MyGameMode->RunnerWidgetManager)
 	{
 		return;
 	}
-	
-	if (!PauseMenuWidgetInstance)
+	URunnerWidgetManager* WidgetManager = MyGameMode->RunnerWidgetManager;
+
+	// Show pause menu
+	if (!WidgetManager->IsWidgetVisible(PauseMenuWidgetClass))
 	{
-		PauseMenuWidgetInstance = CreateWidget<UUserWidget>(GetWorld(), PauseMenuWidgetClass);
+		UUserWidget* PauseMenuWidgetInstance = WidgetManager->ShowWidget(PauseMenuWidgetClass, RunnerWidgetLayer::PauseMenu);
 		if (!PauseMenuWidgetInstance)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("Failed to create PauseMenuWidgetInstance"));
 			return;
 		}
-	}
-
-	// Show pause menu
-	if (!PauseMenuWidgetInstance->IsInViewport())
-	{
-		PauseMenuWidgetInstance->AddToViewport();
 		
 		// Pause game
 		if (APlayerController* MyPlayerController = Cast<APlayerController>(GetController()))
@@ -301,8 +366,7 @@ void ARunnerCharacter::TogglePauseMenu()
 	// Hide pause menu
 	else
 	{
-		PauseMenuWidgetInstance->RemoveFromParent();
-		PauseMenuWidgetInstance = nullptr;
+		WidgetManager->HideWidget(PauseMenuWidgetClass);
 		
 		// Unpause game
 		if (APlayerController* MyPlayerController = Cast<APlayerController>(GetController()))
@@ -322,23 +386,31 @@ void ARunnerCharacter::ShowResumePopup()
 		return;
 	}
 
-	AddWidgetToViewPort(ResumePopupWidgetClass, true);
+	// Shown once per death, Construct starts the popup over
+	AddWidgetToViewPort(ResumePopupWidgetClass, true, RunnerWidgetLayer::ResumePopup, true);
 }
 
-void ARunnerCharacter::AddWidgetToViewPort(const TSubclassOf<UUserWidget>& InWidgetClass, bool bShowMouseCursor) const
+UUserWidget* ARunnerCharacter::AddWidgetToViewPort(const TSubclassOf<UUserWidget>& InWidgetClass, bool bShowMouseCursor, int32 Layer, bool bReconstruct) const
 {
-	if (InWidgetClass)
+	UUserWidget* WidgetInstance = nullptr;
+	if (InWidgetClass && MyGameMode && MyGameMode->RunnerWidgetManager)
 	{
-		if (UUserWidget* WidgetInstance = CreateWidget<UUserWidget>(GetWorld(), InWidgetClass))
-		{
-			WidgetInstance->AddToViewport();
-		}
+		WidgetInstance = MyGameMode->RunnerWidgetManager->ShowWidget(InWidgetClass, Layer, bReconstruct);
 		
 		if (APlayerController* MyPlayerController = Cast<APlayerController>(GetController()))
 		{
 			MyPlayerController->SetShowMouseCursor(bShowMouseCursor);
 		}
 	}
+	return WidgetInstance;
+}
+
+void ARunnerCharacter::RemoveWidgetFromViewPort(const TSubclassOf<UUserWidget>& InWidgetClass) const
+{
+	if (InWidgetClass && MyGameMode && MyGameMode->RunnerWidgetManager)
+	{
+		MyGameMode->RunnerWidgetManager->HideWidget(InWidgetClass);
+	}
 }
 
 void ARunnerCharacter::MagnetPowerupStart()
@@ -350,36 +422,14 @@ void ARunnerCharacter::MagnetPowerupStart()
 	// Broadcast the delegate
 	OnMagnetPowerupStart.Broadcast();
 	
-	// Start a timer to call update timer function
-	float TimerInterval = 0.5f;
-	GetWorld()->GetTimerManager().SetTimer(
-	TimerHandle_Magnet,
-	 FTimerDelegate::CreateUObject(this, &ARunnerCharacter::UpdateMagnetTimer, TimerInterval),
-	 TimerInterval,
-	 true 
-	);
-}
-
-void ARunnerCharacter::UpdateMagnetTimer(float DeltaTime)
-{
-	if (MagnetTimer > 0)
-	{
-		MagnetTimer -= DeltaTime;
-
-		if (MagnetTimer <= 0)
-		{
-			MagnetTimer = 0;
-			MagnetPowerupEnd();
-		}
-	}
+	// The simulation counts down the magnet effect
+	Simulation->QueueMagnet();
 }
 
 void ARunnerCharacter::MagnetPowerupEnd()
 {
 	bIsMagnetActive = false;
 
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_Magnet);
-
 	// Broadcast the delegate
 	OnMagnetPowerupEnd.Broadcast();
 }
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerCheatManager.h"
+#include "RunnerStressSubsystem.h"
+
+URunnerStressSubsystem* URunnerCheatManager::GetStressSubsystem() const
+{
+	URunnerStressSubsystem* Stress = GetWorld() ? GetWorld()->GetSubsystem<URunnerStressSubsystem>() : nullptr;
+	if (!Stress)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URunnerCheatManager: stress testing is not available in this world"));
+	}
+	return Stress;
+}
+
+void URunnerCheatManager::RunnerStressDensity(float Multiplier)
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		FRunnerStressSettings Settings = Stress->GetSettings();
+		Settings.DensityMultiplier = Multiplier;
+		Stress->SetSettings(Settings);
+	}
+}
+
+void URunnerCheatManager::RunnerStressLanes(int32 Multiplier)
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		FRunnerStressSettings Settings = Stress->GetSettings();
+		Settings.LaneMultiplier = Multiplier;
+		Stress->SetSettings(Settings);
+	}
+}
+
+void URunnerCheatManager::RunnerStressMaxSpeed(float Speed)
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		FRunnerStressSettings Settings = Stress->GetSettings();
+		Settings.ForcedMaxSpeed = Speed;
+		Stress->SetSettings(Settings);
+	}
+}
+
+void URunnerCheatManager::RunnerStressTilesAhead(int32 Tiles)
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		Stress->SetTilesAhead(Tiles);
+	}
+}
+
+void URunnerCheatManager::RunnerStressFastForward(int32 Tiles)
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		Stress->FastForward(Tiles);
+	}
+}
+
+void URunnerCheatManager::RunnerStressRamp(float BudgetMs)
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		Stress->StartRamp(BudgetMs);
+	}
+}
+
+void URunnerCheatManager::RunnerStressReset()
+{
+	if (URunnerStressSubsystem* Stress = GetStressSubsystem())
+	{
+		Stress->StopRamp();
+		Stress->SetSettings(FRunnerStressSettings());
+	}
+}
@@ -6,19 +6,30 @@
 #include "RunnerCharacter.h"
 #include "RunnerGameInstance.h"
 #include "RunnerGameMode.h"
+#include "RunnerProfiling.h"
 #include "RunnerScoreManager.h"
+#include "RunnerSimulationComponent.h"
 #include "RunnerSpawnObjectsComponent.h"
+#include "RunnerSpawnLayout.h"
+#include "RunnerStressSubsystem.h"
 #include "RunnerTileManager.h"
 #include "Components/ArrowComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Floor HandleBoxCollision"), STAT_RunnerFloorHandleBoxCollision, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("Floor SpawnAllObjects"), STAT_RunnerFloorSpawnAllObjects, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("Spawn Moving Obstacles"), STAT_RunnerSpawnMovingObstacles, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("Spawn Obstacles"), STAT_RunnerSpawnObstacles, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("Spawn Powerups"), STAT_RunnerSpawnPowerups, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("Spawn Coins"), STAT_RunnerSpawnCoins, STATGROUP_Runner);
+
 // Sets default values
 ARunnerFloorActor::ARunnerFloorActor()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Tiles have nothing to do per frame, Blueprints that implement Tick turn it back on
+	PrimaryActorTick.bCanEverTick = false;
 
 	Scene = CreateDefaultSubobject<USceneComponent>("Scene");
 	RootComponent = Scene;
@@ -37,6 +48,7 @@ ARunnerFloorActor::ARunnerFloorActor()
 	
 	// Create and assign default value for Coin
 	CoinSpawner = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("CoinSpawner"));
+	CoinSpawner->SpawnerType = ERunnerSpawnerType::Coin;
 	CoinSpawner->SpawnSettings.ActorNum = 10;
 	CoinSpawner->SpawnSettings.PointsPerLane = 6;
 	CoinSpawner->SpawnSettings.LaneYOffsets = {-325, 0, 325};
@@ -45,6 +57,7 @@ ARunnerFloorActor::ARunnerFloorActor()
 
 	// Create and assign default value for Powerup
 	PowerupSpawner = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("PowerupSpawner"));
+	PowerupSpawner->SpawnerType = ERunnerSpawnerType::Powerup;
 	PowerupSpawner->SpawnSettings.ActorNum = 1;
 	PowerupSpawner->SpawnSettings.PointsPerLane = 6;
 	PowerupSpawner->SpawnSettings.LaneYOffsets = {-325, 0, 325};
@@ -55,6 +68,7 @@ ARunnerFloorActor::ARunnerFloorActor()
 
 	// Create and assign default value for Obstacle
 	ObstacleSpawner = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("ObstacleSpawner"));
+	ObstacleSpawner->SpawnerType = ERunnerSpawnerType::Obstacle;
 	ObstacleSpawner->SpawnSettings.ActorNum = 1;
 	ObstacleSpawner->SpawnSettings.PointsPerLane = 2;
 	ObstacleSpawner->SpawnSettings.LaneYOffsets = {-325, 0, 325};
@@ -63,6 +77,7 @@ ARunnerFloorActor::ARunnerFloorActor()
 
 	// Create and assign default value for Moving Obstacle
 	MovingObstacleSpawner = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("MovingObstacleSpawner"));
+	MovingObstacleSpawner->SpawnerType = ERunnerSpawnerType::MovingObstacle;
 	MovingObstacleSpawner->SpawnSettings.ActorNum = 1;
 	MovingObstacleSpawner->SpawnSettings.PointsPerLane = 2;
 	MovingObstacleSpawner->SpawnSettings.LaneYOffsets = {-325, 0, 325};
@@ -71,6 +86,9 @@ ARunnerFloorActor::ARunnerFloorActor()
 	MovingObstacleSpawner->SpawnSettings.ActorRotator = FRotator(0, 180, 0);
 	MovingObstacleSpawner->SpawnSettings.SpawnIntervalBase = 8;
 	MovingObstacleSpawner->SpawnSettings.SpawnIntervalRandomOffset = 2;
+
+	// Moving obstacles start moving when spawned, deferring them would change where the player meets them
+	MovingObstacleSpawner->bAllowDeferredSpawn = false;
 }
 
 void ARunnerFloorActor::OnConstruction(const FTransform& Transform)
@@ -113,6 +131,8 @@ FVector ARunnerFloorActor::GetAttachLocation_Implementation() const
 
 void ARunnerFloorActor::HandleBoxCollision_Implementation(AActor* OverlappingActor)
 {
+	RUNNER_SCOPE_CYCLE(STAT_RunnerFloorHandleBoxCollision);
+
 	// Check if the overlapping actor is the player
 	ARunnerCharacter* MyCharacter = Cast<ARunnerCharacter>(OverlappingActor);
 	if (!MyCharacter)
@@ -131,6 +151,12 @@ void ARunnerFloorActor::HandleBoxCollision_Implementation(AActor* OverlappingAct
 		UE_LOG(LogTemp, Warning, TEXT("GameMode or RunnerFloorManager is NULL!"));
 	}
 
+	// The simulation of the player counts passed tiles from its track position when it knows the tile length
+	if (MyCharacter->GetSimulation() && MyCharacter->GetSimulation()->Config.TileLength > 0)
+	{
+		return;
+	}
+
 	// Update Speed
 	IncreaseSpeed(OverlappingActor, SpeedIncrement, MaxSpeed);
 	
@@ -140,33 +166,68 @@ void ARunnerFloorActor::HandleBoxCollision_Implementation(AActor* OverlappingAct
 
 void ARunnerFloorActor::SpawnAllObjects()
 {
+	RUNNER_SCOPE_CYCLE(STAT_RunnerFloorSpawnAllObjects);
+
+#if !UE_BUILD_SHIPPING
+	// Stress test overrides of the spawn and speed settings
+	if (const URunnerStressSubsystem* Stress = GetWorld() ? GetWorld()->GetSubsystem<URunnerStressSubsystem>() : nullptr)
+	{
+		Stress->ApplyToFloor(*this);
+	}
+#endif
+
+	// Use the layout stream of the floor manager in game, a random one in the editor
+	ARunnerGameMode* MyGameMode = GetWorld() ? Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode()) : nullptr;
+	const FRandomStream EditorRandomStream(FMath::Rand());
+	const FRandomStream& RandomStream = (MyGameMode && MyGameMode->RunnerFloorManager)
+		? MyGameMode->RunnerFloorManager->GetRandomStream()
+		: EditorRandomStream;
+
+	// Far tiles only plan their objects, the floor manager spawns them when the player gets close
+	const bool bDeferObjects = MyGameMode && MyGameMode->RunnerFloorManager && MyGameMode->RunnerFloorManager->ShouldDeferObjects(GetActorLocation());
+	auto SpawnOrPlanObjects = [this, bDeferObjects, &RandomStream](URunnerSpawnObjectsComponent* Spawner)
+	{
+		if (bDeferObjects && Spawner->bAllowDeferredSpawn)
+		{
+			Spawner->PlanObjects(FloorComponent, RandomStream);
+		}
+		else
+		{
+			Spawner->SpawnObjects(FloorComponent, RandomStream);
+		}
+	};
+
 	if (MovingObstacleSpawner)
 	{
 		// Moving Obstacles are not spawned on every floor
-		int32 SpawnIntervalBase = MovingObstacleSpawner->SpawnSettings.SpawnIntervalBase;
-		int32 SpawnIntervalRandomOffset = MovingObstacleSpawner->SpawnSettings.SpawnIntervalRandomOffset;
+		int32 SpawnIntervalBase = MovingObstacleSpawner->GetSpawnSettings().SpawnIntervalBase;
+		int32 SpawnIntervalRandomOffset = MovingObstacleSpawner->GetSpawnSettings().SpawnIntervalRandomOffset;
 		if (ShouldSpawnObjects(SpawnIntervalBase, SpawnIntervalRandomOffset))
 		{
-			MovingObstacleSpawner->SpawnObjects(FloorComponent);
+			RUNNER_SCOPE_CYCLE(STAT_RunnerSpawnMovingObstacles);
+			SpawnOrPlanObjects(MovingObstacleSpawner);
 		}
 	}
 	if (ObstacleSpawner)
 	{
-		ObstacleSpawner->SpawnObjects(FloorComponent);
+		RUNNER_SCOPE_CYCLE(STAT_RunnerSpawnObstacles);
+		SpawnOrPlanObjects(ObstacleSpawner);
 	}
 	if (PowerupSpawner)
 	{
 		// Powerups are not spawned on every floor
-		int32 SpawnIntervalBase = PowerupSpawner->SpawnSettings.SpawnIntervalBase;
-		int32 SpawnIntervalRandomOffset = PowerupSpawner->SpawnSettings.SpawnIntervalRandomOffset;
+		int32 SpawnIntervalBase = PowerupSpawner->GetSpawnSettings().SpawnIntervalBase;
+		int32 SpawnIntervalRandomOffset = PowerupSpawner->GetSpawnSettings().SpawnIntervalRandomOffset;
 		if (ShouldSpawnObjects(SpawnIntervalBase, SpawnIntervalRandomOffset))
 		{
-			PowerupSpawner->SpawnObjects(FloorComponent);
+			RUNNER_SCOPE_CYCLE(STAT_RunnerSpawnPowerups);
+			SpawnOrPlanObjects(PowerupSpawner);
 		}
 	}
 	if (CoinSpawner)
 	{
-		CoinSpawner->SpawnObjects(FloorComponent);
+		RUNNER_SCOPE_CYCLE(STAT_RunnerSpawnCoins);
+		SpawnOrPlanObjects(CoinSpawner);
 	}
 }
 
@@ -181,8 +242,8 @@ bool ARunnerFloorActor::ShouldSpawnObjects(int32 SpawnIntervalBase, int32 SpawnI
 	ARunnerGameMode* MyGameMode = Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode());
 	if (MyGameMode && MyGameMode->RunnerFloorManager)
 	{
-		int32 RandomizedInterval = SpawnIntervalBase + FMath::RandRange(-SpawnIntervalRandomOffset, SpawnIntervalRandomOffset);
-		return ((MyGameMode->RunnerFloorManager->TileCount % RandomizedInterval) == 0);
+		const URunnerTileManager* FloorManager = MyGameMode->RunnerFloorManager;
+		return RunnerSpawnLayout::ShouldSpawnOnTile(FloorManager->TileCount, SpawnIntervalBase, SpawnIntervalRandomOffset, FloorManager->GetRandomStream());
 	}
 
 	return false;
@@ -190,12 +251,11 @@ bool ARunnerFloorActor::ShouldSpawnObjects(int32 SpawnIntervalBase, int32 SpawnI
 
 void ARunnerFloorActor::IncreaseSpeed(AActor* Actor, float Increment, float Max)
 {
+	// The simulation applies the speed change on its next fixed step
 	ARunnerCharacter* MyCharacter = Cast<ARunnerCharacter>(Actor);
-	if (MyCharacter && MyCharacter->GetCharacterMovement())
+	if (MyCharacter && MyCharacter->GetSimulation())
 	{
-		float NewSpeed = MyCharacter->GetCharacterMovement()->MaxWalkSpeed + Increment;
-		
-		MyCharacter->GetCharacterMovement()->MaxWalkSpeed = FMath::Min(NewSpeed, Max);
+		MyCharacter->GetSimulation()->QueueTilePassed(Increment, Max);
 	}
 }
 
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerGCManager.h"
+#include "RunnerCharacter.h"
+#include "LoadingScreenModule.h"
+
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/UObjectGlobals.h"
+
+URunnerGCManager::URunnerGCManager()
+{
+	// Safe points are reached while the game is paused
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bTickEvenWhenPaused = true;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void URunnerGCManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &URunnerGCManager::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &URunnerGCManager::OnPostGarbageCollect);
+	LastGCTime = FPlatformTime::Seconds();
+}
+
+void URunnerGCManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	LogStateStats();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+ERunnerRunState URunnerGCManager::ComputeRunState()
+{
+	FLoadingScreenModule* LoadingScreenModule = FModuleManager::GetModulePtr<FLoadingScreenModule>("LoadingScreenModule");
+	if (LoadingScreenModule && LoadingScreenModule->GetWarmup().IsHoldingLoadingScreen())
+	{
+		return ERunnerRunState::Loading;
+	}
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (MyCharacter && MyCharacter->bIsDead)
+	{
+		return ERunnerRunState::Dead;
+	}
+	return GetWorld()->IsPaused() ? ERunnerRunState::Paused : ERunnerRunState::Running;
+}
+
+void URunnerGCManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	RunState = ComputeRunState();
+	const double Now = FPlatformTime::Seconds();
+
+	if (RunState == ERunnerRunState::Running)
+	{
+		bCollectedAtSafePoint = false;
+
+		// Deferred for this frame only, the engine still collects when it runs low on memory
+		if (bDeferWhileRunning && Now - LastGCTime < MaxDeferSeconds)
+		{
+			GEngine->DelayGarbageCollection();
+		}
+		return;
+	}
+
+	// Death pauses the game after a delay, the collection waits for the pause
+	if (!bCollectedAtSafePoint && GetWorld()->IsPaused() && Now - LastGCTime >= MinSafePointInterval)
+	{
+		bCollectedAtSafePoint = true;
+		GEngine->ForceGarbageCollection(true);
+	}
+}
+
+void URunnerGCManager::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+	CollectingState = RunState;
+}
+
+void URunnerGCManager::OnPostGarbageCollect()
+{
+	if (GCStartTime <= 0)
+	{
+		return;
+	}
+
+	LastGCTime = FPlatformTime::Seconds();
+	const double PauseMs = (LastGCTime - GCStartTime) * 1000.0;
+	GCStartTime = 0;
+
+	FRunnerGCStateStats& Stats = StateStats[static_cast<int32>(CollectingState)];
+	++Stats.Count;
+	Stats.TotalMs += PauseMs;
+	Stats.MaxMs = FMath::Max(Stats.MaxMs, PauseMs);
+}
+
+void URunnerGCManager::LogStateStats() const
+{
+	const UEnum* StateEnum = StaticEnum<ERunnerRunState>();
+	for (int32 Index = 0; Index < static_cast<int32>(ERunnerRunState::Num); ++Index)
+	{
+		const FRunnerGCStateStats& Stats = StateStats[Index];
+		UE_LOG(LogTemp, Display, TEXT("URunnerGCManager: %-8s %3d collections, %8.2f ms total, %7.2f ms max"),
+			*StateEnum->GetNameStringByIndex(Index), Stats.Count, Stats.TotalMs, Stats.MaxMs);
+	}
+}
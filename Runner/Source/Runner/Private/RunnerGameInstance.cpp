@@ -4,9 +4,13 @@
 #include "RunnerGameInstance.h"
 
 #include "LoadingScreenModule.h"
+#include "RunnerProfiling.h"
 #include "RunnerSaveGame.h"
 #include "Kismet/GameplayStatics.h"
 
+DECLARE_CYCLE_STAT(TEXT("LoadGameFromSlot"), STAT_RunnerLoadGameFromSlot, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("SaveGameToSlot"), STAT_RunnerSaveGameToSlot, STATGROUP_Runner);
+
 void URunnerGameInstance::Init()
 {
 	Super::Init();
@@ -65,6 +69,7 @@ void URunnerGameInstance::CreateSaveGameObject(const TSubclassOf<URunnerSaveGame
 		return;
 	}
 	
+	LLM_SCOPE_BYTAG(Runner_SaveGame);
 	MySaveGame = Cast<URunnerSaveGame>(UGameplayStatics::CreateSaveGameObject(SaveGameClass));
 	if (!MySaveGame)
 	{
@@ -74,6 +79,9 @@ void URunnerGameInstance::CreateSaveGameObject(const TSubclassOf<URunnerSaveGame
 
 void URunnerGameInstance::LoadGameFromSlot(const FString& SlotName, const int32 UserIndex)
 {
+	RUNNER_SCOPE_CYCLE(STAT_RunnerLoadGameFromSlot);
+	LLM_SCOPE_BYTAG(Runner_SaveGame);
+
 	MySaveGame = Cast<URunnerSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
 	if (!MySaveGame)
 	{
@@ -83,6 +91,10 @@ void URunnerGameInstance::LoadGameFromSlot(const FString& SlotName, const int32
 
 void URunnerGameInstance::SaveGameToSlot(URunnerSaveGame* SaveGameObject, const FString& SlotName, const int32 UserIndex) const
 {
+	RUNNER_SCOPE_COST(SaveGame);
+	RUNNER_SCOPE_CYCLE(STAT_RunnerSaveGameToSlot);
+	LLM_SCOPE_BYTAG(Runner_SaveGame);
+
 	const bool bSuccess = UGameplayStatics::SaveGameToSlot(MySaveGame, SlotName, UserIndex);
 	if (!bSuccess)
 	{
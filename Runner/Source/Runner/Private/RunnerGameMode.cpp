@@ -1,8 +1,16 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "RunnerGameMode.h"
+#include "RunnerAutopilotController.h"
+#include "RunnerGCManager.h"
 #include "RunnerTileManager.h"
 #include "RunnerScoreManager.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerWidgetManager.h"
+#include "LoadingScreenModule.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "UObject/ConstructorHelpers.h"
 
 ARunnerGameMode::ARunnerGameMode()
@@ -11,8 +19,42 @@ ARunnerGameMode::ARunnerGameMode()
 	PrimaryActorTick.bCanEverTick = false;
 	
 	RunnerFloorManager = CreateDefaultSubobject<URunnerTileManager>("FloorManager");
+	RunnerFloorManager->MaterializeDistance = 4000.0f;
+	// Reclaim where the Behind significance tier ends, skyline objects are not reclaimed and fall into the Passed tier
+	RunnerFloorManager->ReclaimDistance = 2000.0f;
 	RunnerSkylineManager = CreateDefaultSubobject<URunnerTileManager>("SkylineManager");
+	RunnerSkylineManager->bIsSkyline = true;
 	RunnerScoreManager = CreateDefaultSubobject<URunnerScoreManager>("ScoreManager");
+	RunnerWidgetManager = CreateDefaultSubobject<URunnerWidgetManager>("WidgetManager");
+	RunnerGCManager = CreateDefaultSubobject<URunnerGCManager>("GCManager");
+
+	AutopilotControllerClass = ARunnerAutopilotController::StaticClass();
+}
+
+void ARunnerGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	// Benchmarks, soaks and stress ramps always run on the autopilot
+	FString RampBudget;
+	const bool bBenchmark = FParse::Param(FCommandLine::Get(), TEXT("RunnerBenchmark")) || FParse::Param(FCommandLine::Get(), TEXT("RunnerSoak"))
+		|| FParse::Param(FCommandLine::Get(), TEXT("RunnerStressRamp")) || FParse::Value(FCommandLine::Get(), TEXT("RunnerStressRamp="), RampBudget);
+	if (!AutopilotControllerClass || (!bBenchmark && !UGameplayStatics::HasOption(Options, TEXT("Autopilot")) && !FParse::Param(FCommandLine::Get(), TEXT("Autopilot"))))
+	{
+		return;
+	}
+	PlayerControllerClass = AutopilotControllerClass;
+
+	// Deterministic autopilot sessions also fix the tile layouts
+	const ARunnerAutopilotController* AutopilotDefaults = AutopilotControllerClass->GetDefaultObject<ARunnerAutopilotController>();
+	int32 Seed = (AutopilotDefaults->bDeterministic || bBenchmark) ? AutopilotDefaults->Seed : 0;
+	FParse::Value(FCommandLine::Get(), TEXT("AutopilotSeed="), Seed);
+	if (Seed != 0)
+	{
+		RunnerFloorManager->RandomSeed = Seed;
+		RunnerSkylineManager->RandomSeed = Seed;
+	}
+	UE_LOG(LogTemp, Display, TEXT("ARunnerGameMode: autopilot enabled with %s"), *AutopilotControllerClass->GetName());
 }
 
 void ARunnerGameMode::BeginPlay()
@@ -21,4 +63,83 @@ void ARunnerGameMode::BeginPlay()
 
 	RunnerFloorManager->InitiateTile();
 	RunnerSkylineManager->InitiateTile();
+
+	RegisterWarmupTasks();
+}
+
+void ARunnerGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (FLoadingScreenModule* LoadingScreenModule = FModuleManager::GetModulePtr<FLoadingScreenModule>("LoadingScreenModule"))
+	{
+		LoadingScreenModule->GetWarmup().OnFinished().RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARunnerGameMode::RegisterWarmupTasks()
+{
+	FLoadingScreenModule* LoadingScreenModule = FModuleManager::LoadModulePtr<FLoadingScreenModule>("LoadingScreenModule");
+	if (!LoadingScreenModule)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ARunnerGameMode::RegisterWarmupTasks: LoadingScreenModule not found"));
+		return;
+	}
+	FLoadingScreenWarmup& Warmup = LoadingScreenModule->GetWarmup();
+
+	// Keep the run paused until the loading screen is released
+	if (Warmup.IsHoldingLoadingScreen())
+	{
+		UGameplayStatics::SetGamePaused(this, true);
+		Warmup.OnFinished().AddUObject(this, &ARunnerGameMode::OnWarmupFinished);
+	}
+
+	// Collect the classes spawned on tiles
+	TSharedRef<TArray<TWeakObjectPtr<UClass>>> SpawnClasses = MakeShared<TArray<TWeakObjectPtr<UClass>>>();
+	for (const URunnerTileManager* TileManager : { RunnerFloorManager.Get(), RunnerSkylineManager.Get() })
+	{
+		if (!TileManager || !TileManager->TileClass)
+		{
+			continue;
+		}
+
+		TInlineComponentArray<URunnerSpawnObjectsComponent*> Spawners;
+		TileManager->TileClass->GetDefaultObject<AActor>()->GetComponents(Spawners);
+		for (const URunnerSpawnObjectsComponent* Spawner : Spawners)
+		{
+			for (const TSubclassOf<AActor>& ActorClass : Spawner->GetSpawnSettings().ActorClasses)
+			{
+				if (ActorClass)
+				{
+					SpawnClasses->AddUnique(ActorClass.Get());
+				}
+			}
+		}
+	}
+
+	// Touch one spawn class per step so its default object and assets are resident before the first spawn
+	const int32 ClassNum = SpawnClasses->Num();
+	TSharedRef<int32> NextIndex = MakeShared<int32>(0);
+	Warmup.RegisterTask(TEXT("TouchSpawnClasses"), [SpawnClasses, NextIndex, ClassNum]()
+	{
+		if (*NextIndex < ClassNum)
+		{
+			if (UClass* SpawnClass = (*SpawnClasses)[*NextIndex].Get())
+			{
+				SpawnClass->GetDefaultObject();
+			}
+			++(*NextIndex);
+		}
+		return ClassNum > 0 ? static_cast<float>(*NextIndex) / ClassNum : 1.0f;
+	});
+}
+
+void ARunnerGameMode::OnWarmupFinished()
+{
+	if (FLoadingScreenModule* LoadingScreenModule = FModuleManager::GetModulePtr<FLoadingScreenModule>("LoadingScreenModule"))
+	{
+		LoadingScreenModule->GetWarmup().OnFinished().RemoveAll(this);
+	}
+
+	UGameplayStatics::SetGamePaused(this, false);
 }
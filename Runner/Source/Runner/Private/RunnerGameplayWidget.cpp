@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerGameplayWidget.h"
+
+#include "RunnerGameMode.h"
+#include "RunnerScoreManager.h"
+#include "Components/InvalidationBox.h"
+#include "Components/TextBlock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Widgets/SInvalidationPanel.h"
+
+void URunnerGameplayWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	PaintCount = 0;
+	UpdateCount = 0;
+	ConstructTime = FPlatformTime::Seconds();
+
+	if (HUDInvalidationBox)
+	{
+		HUDInvalidationBox->SetCanCache(true);
+	}
+
+	const ARunnerGameMode* MyGameMode = GetWorld() ? Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode()) : nullptr;
+	if (!MyGameMode || !MyGameMode->RunnerScoreManager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GameMode or RunnerScoreManager is NULL!"));
+		return;
+	}
+	ScoreManager = MyGameMode->RunnerScoreManager;
+
+	ScoreManager->OnScoreChanged.AddUniqueDynamic(this, &URunnerGameplayWidget::HandleScoreChanged);
+	ScoreManager->OnCoinsChanged.AddUniqueDynamic(this, &URunnerGameplayWidget::HandleCoinsChanged);
+	ScoreManager->OnHighScoreChanged.AddUniqueDynamic(this, &URunnerGameplayWidget::HandleHighScoreChanged);
+
+	// Show the current values once
+	HandleScoreChanged(ScoreManager->CurrentScore, 0);
+	HandleCoinsChanged(ScoreManager->CurrentCoins, 0);
+	HandleHighScoreChanged(ScoreManager->HighScore, 0);
+}
+
+void URunnerGameplayWidget::NativeDestruct()
+{
+	if (ScoreManager)
+	{
+		ScoreManager->OnScoreChanged.RemoveAll(this);
+		ScoreManager->OnCoinsChanged.RemoveAll(this);
+		ScoreManager->OnHighScoreChanged.RemoveAll(this);
+		ScoreManager = nullptr;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerGameplayWidget: %d repaints for %d updates in %.1fs"),
+		PaintCount, UpdateCount, FPlatformTime::Seconds() - ConstructTime);
+
+	Super::NativeDestruct();
+}
+
+int32 URunnerGameplayWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(URunnerGameplayWidget::NativePaint);
+
+	const int32 MaxLayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	// This widget paints every frame, the invalidation panel below it tells whether the cached HUD was repainted
+	const TSharedPtr<SWidget> Panel = HUDInvalidationBox ? HUDInvalidationBox->GetCachedWidget() : nullptr;
+	if (!Panel || StaticCastSharedPtr<SInvalidationPanel>(Panel)->GetLastPaintType() != ESlateInvalidationPaintType::None)
+	{
+		++PaintCount;
+	}
+	return MaxLayerId;
+}
+
+void URunnerGameplayWidget::HandleScoreChanged(int32 NewValue, int32 Delta)
+{
+	++UpdateCount;
+	if (ScoreText)
+	{
+		ScoreText->SetText(FText::AsNumber(NewValue));
+	}
+	OnScoreUpdated(NewValue, Delta);
+}
+
+void URunnerGameplayWidget::HandleCoinsChanged(int32 NewValue, int32 Delta)
+{
+	++UpdateCount;
+	if (CoinsText)
+	{
+		CoinsText->SetText(FText::AsNumber(NewValue));
+	}
+	OnCoinsUpdated(NewValue, Delta);
+}
+
+void URunnerGameplayWidget::HandleHighScoreChanged(int32 NewValue, int32 Delta)
+{
+	++UpdateCount;
+	if (HighScoreText)
+	{
+		HighScoreText->SetText(FText::AsNumber(NewValue));
+	}
+	OnHighScoreUpdated(NewValue, Delta);
+}
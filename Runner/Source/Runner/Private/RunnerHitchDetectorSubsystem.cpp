@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerHitchDetectorSubsystem.h"
+#include "RunnerGameMode.h"
+#include "RunnerProfiling.h"
+#include "RunnerTileManager.h"
+
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace RunnerHitchDetector
+{
+	/** Seconds between appends to the log */
+	constexpr double FlushInterval = 5;
+
+	/** Seconds recorded after a hitch before the snapshot is written, the trace buffer holds the seconds before it */
+	constexpr double SnapshotDelay = 2;
+
+	/** Minimum seconds between snapshots */
+	constexpr double SnapshotInterval = 30;
+}
+
+bool URunnerHitchDetectorSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("RunnerHitches")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool URunnerHitchDetectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerHitchDetectorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("HitchBudgetMs="), BudgetMs);
+	bWriteSnapshots = FParse::Param(FCommandLine::Get(), TEXT("HitchSnapshot"));
+	LogPath = FPaths::ProjectLogDir() / TEXT("RunnerHitches.log");
+
+	const int32 CounterCount = FRunnerCostCounter::GetAll().Num();
+	LastCallCounts.SetNumZeroed(CounterCount);
+	LastTotalSeconds.SetNumZeroed(CounterCount);
+	PendingRecords.Reserve(64);
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &URunnerHitchDetectorSubsystem::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &URunnerHitchDetectorSubsystem::OnPostGarbageCollect);
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerHitchDetectorSubsystem: logging frames over %.1f ms to %s"), BudgetMs, *LogPath);
+}
+
+void URunnerHitchDetectorSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	Flush();
+	if (HitchCount > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("URunnerHitchDetectorSubsystem: %d hitches over %.1f ms logged to %s"), HitchCount, BudgetMs, *LogPath);
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId URunnerHitchDetectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerHitchDetectorSubsystem, STATGROUP_Tickables);
+}
+
+void URunnerHitchDetectorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Paused frames and the first frame are not measured
+	if (LastTickTime > 0 && !GetWorld()->IsPaused())
+	{
+		const double FrameSeconds = Now - LastTickTime;
+		if (FrameSeconds * 1000.0 > BudgetMs)
+		{
+			RecordHitch(FrameSeconds);
+		}
+	}
+	ResetFrame();
+	LastTickTime = Now;
+
+	if (SnapshotTime > 0 && Now >= SnapshotTime)
+	{
+		SnapshotTime = 0;
+		LastSnapshotTime = Now;
+		const FString SnapshotPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / FString::Printf(TEXT("RunnerHitch-%s.utrace"), *FDateTime::Now().ToString());
+		if (FTraceAuxiliary::WriteSnapshot(*SnapshotPath))
+		{
+			UE_LOG(LogTemp, Display, TEXT("URunnerHitchDetectorSubsystem: wrote Insights snapshot %s"), *SnapshotPath);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("URunnerHitchDetectorSubsystem: failed to write an Insights snapshot, is tracing enabled?"));
+		}
+	}
+
+	if (PendingRecords.Num() > 0 && Now - LastFlushTime >= RunnerHitchDetector::FlushInterval)
+	{
+		Flush();
+	}
+}
+
+void URunnerHitchDetectorSubsystem::ResetFrame()
+{
+	const TArray<FRunnerCostCounter*>& Counters = FRunnerCostCounter::GetAll();
+	for (int32 Index = 0; Index < Counters.Num(); ++Index)
+	{
+		LastCallCounts[Index] = Counters[Index]->GetCallCount();
+		LastTotalSeconds[Index] = Counters[Index]->GetTotalSeconds();
+	}
+	FrameGCSeconds = 0;
+}
+
+void URunnerHitchDetectorSubsystem::RecordHitch(double FrameSeconds)
+{
+	++HitchCount;
+
+	// Scopes that ran during the frame, with their call counts and total durations, slowest first
+	struct FScopeCost
+	{
+		const TCHAR* Name;
+		int32 Calls;
+		double Seconds;
+	};
+	TArray<FScopeCost, TInlineAllocator<16>> Scopes;
+	const TArray<FRunnerCostCounter*>& Counters = FRunnerCostCounter::GetAll();
+	for (int32 Index = 0; Index < Counters.Num(); ++Index)
+	{
+		const int32 Calls = Counters[Index]->GetCallCount() - LastCallCounts[Index];
+		if (Calls > 0)
+		{
+			Scopes.Add({Counters[Index]->GetName(), Calls, Counters[Index]->GetTotalSeconds() - LastTotalSeconds[Index]});
+		}
+	}
+	if (FrameGCSeconds > 0)
+	{
+		Scopes.Add({TEXT("GC"), 1, FrameGCSeconds});
+	}
+	Scopes.Sort([](const FScopeCost& A, const FScopeCost& B) { return A.Seconds > B.Seconds; });
+
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	const int32 TileCount = MyGameMode && MyGameMode->RunnerFloorManager ? MyGameMode->RunnerFloorManager->TileCount : 0;
+
+	FString Record = FString::Printf(TEXT("[%s] frame %llu %.1f ms tile %d"), *FDateTime::Now().ToString(), GFrameCounter, FrameSeconds * 1000.0, TileCount);
+	for (const FScopeCost& Scope : Scopes)
+	{
+		Record += FString::Printf(TEXT(" | %s %dx %.2f ms"), Scope.Name, Scope.Calls, Scope.Seconds * 1000.0);
+	}
+	if (Scopes.Num() == 0)
+	{
+		Record += TEXT(" | no runner scope");
+	}
+	UE_LOG(LogTemp, Warning, TEXT("Hitch: %s"), *Record);
+	PendingRecords.Add(MoveTemp(Record));
+
+	if (bWriteSnapshots && SnapshotTime == 0 && (LastSnapshotTime == 0 || FPlatformTime::Seconds() - LastSnapshotTime >= RunnerHitchDetector::SnapshotInterval))
+	{
+		SnapshotTime = FPlatformTime::Seconds() + RunnerHitchDetector::SnapshotDelay;
+	}
+}
+
+void URunnerHitchDetectorSubsystem::Flush()
+{
+	LastFlushTime = FPlatformTime::Seconds();
+	if (PendingRecords.Num() == 0)
+	{
+		return;
+	}
+
+	FString Text = FString::Join(PendingRecords, LINE_TERMINATOR) + LINE_TERMINATOR;
+	if (!FFileHelper::SaveStringToFile(Text, *LogPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Error, TEXT("URunnerHitchDetectorSubsystem: failed to write %s"), *LogPath);
+	}
+	PendingRecords.Reset();
+}
+
+void URunnerHitchDetectorSubsystem::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void URunnerHitchDetectorSubsystem::OnPostGarbageCollect()
+{
+	if (GCStartTime > 0)
+	{
+		FrameGCSeconds += FPlatformTime::Seconds() - GCStartTime;
+	}
+	GCStartTime = 0;
+}
@@ -0,0 +1,296 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerPerfBaselines.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace RunnerPerfMetrics
+{
+	struct FMetricDefinition
+	{
+		const TCHAR* Name;
+		const TCHAR* Subsystem;
+		double DefaultTolerance;
+
+		/** Changes below this absolute amount are treated as noise */
+		double MinAbsoluteChange;
+
+		bool bAttributable;
+	};
+
+	const FMetricDefinition Definitions[] =
+	{
+		{ TEXT("FrameTimeMs.P50"), TEXT("Frame"), 0.10, 0.5, false },
+		{ TEXT("FrameTimeMs.P95"), TEXT("Frame"), 0.15, 0.5, false },
+		{ TEXT("FrameTimeMs.P99"), TEXT("Frame"), 0.20, 1.0, false },
+		{ TEXT("GameThreadMs.P95"), TEXT("Game thread"), 0.15, 0.5, false },
+		{ TEXT("SpawnMsPerTile"), TEXT("Spawning (URunnerSpawnObjectsComponent::SpawnObjects)"), 0.15, 0.05, true },
+		{ TEXT("SpawnObjectsMs.P95"), TEXT("Spawning (URunnerSpawnObjectsComponent::SpawnObjects)"), 0.20, 0.05, true },
+		{ TEXT("AddTileMs.P95"), TEXT("Tile manager (URunnerTileManager::AddTile)"), 0.20, 0.1, true },
+		{ TEXT("RemoveTileMs.P95"), TEXT("Tile manager (URunnerTileManager::RemoveTile)"), 0.20, 0.1, true },
+		{ TEXT("GCPauseMs.P95"), TEXT("Garbage collection"), 0.25, 1.0, true },
+		{ TEXT("GCPauseMs.Max"), TEXT("Garbage collection"), 0.50, 2.0, true },
+		{ TEXT("ActorsAtTile500"), TEXT("Actor lifetime (tile spawning and removal)"), 0.05, 5, true },
+		{ TEXT("PeakUsedPhysicalMB"), TEXT("Memory"), 0.10, 32, true },
+		{ TEXT("MemoryMB.Runner_Tiles"), TEXT("Tile memory (LLM Runner/Tiles)"), 0.10, 1, true },
+		{ TEXT("MemoryMB.Runner_Skyline"), TEXT("Skyline memory (LLM Runner/Skyline)"), 0.10, 1, true },
+		{ TEXT("MemoryMB.Runner_Spawned_Coins"), TEXT("Coin memory (LLM Runner/Spawned/Coins)"), 0.10, 1, true },
+		{ TEXT("MemoryMB.Runner_Spawned_Obstacles"), TEXT("Obstacle memory (LLM Runner/Spawned/Obstacles)"), 0.10, 1, true },
+		{ TEXT("MemoryMB.Runner_Spawned_Scenery"), TEXT("Scenery memory (LLM Runner/Spawned/Scenery)"), 0.10, 1, true },
+		{ TEXT("MemoryMB.Runner_UI"), TEXT("UI memory (LLM Runner/UI)"), 0.10, 1, true },
+	};
+
+	/** Read a metric from a report, "A.B" reads Metrics.A.B and ActorsAtTileN reads the CountsAtTile sample of tile N */
+	bool ReadMetric(const FJsonObject& Report, const FString& Name, double& OutValue)
+	{
+		FString Distribution, Field;
+		if (Name.Split(TEXT("."), &Distribution, &Field))
+		{
+			const TSharedPtr<FJsonObject>* Metrics = nullptr;
+			const TSharedPtr<FJsonObject>* Samples = nullptr;
+			return Report.TryGetObjectField(TEXT("Metrics"), Metrics)
+				&& (*Metrics)->TryGetObjectField(Distribution, Samples)
+				&& (*Samples)->TryGetNumberField(Field, OutValue);
+		}
+
+		const FString ActorsAtTilePrefix = TEXT("ActorsAtTile");
+		if (Name.StartsWith(ActorsAtTilePrefix))
+		{
+			const int32 Tile = FCString::Atoi(*Name.RightChop(ActorsAtTilePrefix.Len()));
+			const TArray<TSharedPtr<FJsonValue>>* Counts = nullptr;
+			if (Report.TryGetArrayField(TEXT("CountsAtTile"), Counts))
+			{
+				for (const TSharedPtr<FJsonValue>& Count : *Counts)
+				{
+					const TSharedPtr<FJsonObject> Entry = Count->AsObject();
+					if (Entry && Entry->GetIntegerField(TEXT("Tile")) == Tile)
+					{
+						return Entry->TryGetNumberField(TEXT("Actors"), OutValue);
+					}
+				}
+			}
+			return false;
+		}
+
+		return Report.TryGetNumberField(Name, OutValue);
+	}
+}
+
+FRunnerPerfBaselines::FRunnerPerfBaselines()
+	: Root(MakeShared<FJsonObject>())
+{
+}
+
+FString FRunnerPerfBaselines::GetDefaultPath()
+{
+	return FPaths::ProjectDir() / TEXT("Build") / TEXT("PerfBaselines") / TEXT("RunnerPerfBaselines.json");
+}
+
+bool FRunnerPerfBaselines::Load(const FString& Path, bool bAllowMissing)
+{
+	Root = MakeShared<FJsonObject>();
+
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *Path))
+	{
+		if (!bAllowMissing)
+		{
+			UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: %s not found, record a baseline with RunnerPerfGate -Update"), *Path);
+			return false;
+		}
+		UE_LOG(LogTemp, Display, TEXT("FRunnerPerfBaselines: %s not found, starting with no baselines"), *Path);
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> LoadedRoot;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), LoadedRoot) || !LoadedRoot)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: failed to parse %s"), *Path);
+		return false;
+	}
+	Root = LoadedRoot.ToSharedRef();
+	return true;
+}
+
+bool FRunnerPerfBaselines::Save(const FString& Path) const
+{
+	Root->SetNumberField(TEXT("Version"), 1);
+
+	FString Json;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+	if (!FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: failed to write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+void FRunnerPerfBaselines::SetBaseline(const FString& Name, const FJsonObject& Report)
+{
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	for (const RunnerPerfMetrics::FMetricDefinition& Definition : RunnerPerfMetrics::Definitions)
+	{
+		double Value = 0;
+		if (RunnerPerfMetrics::ReadMetric(Report, Definition.Name, Value))
+		{
+			Metrics->SetNumberField(Definition.Name, Value);
+		}
+	}
+
+	TSharedRef<FJsonObject> Baseline = MakeShared<FJsonObject>();
+	Baseline->SetStringField(TEXT("Build"), Report.GetStringField(TEXT("Build")));
+	Baseline->SetNumberField(TEXT("Changelist"), Report.GetNumberField(TEXT("Changelist")));
+	Baseline->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+	Baseline->SetObjectField(TEXT("Metrics"), Metrics);
+
+	// Keep tolerance overrides of the existing baseline
+	const TSharedPtr<FJsonObject>* Baselines = nullptr;
+	const TSharedPtr<FJsonObject>* Existing = nullptr;
+	const TSharedPtr<FJsonObject>* Tolerances = nullptr;
+	if (Root->TryGetObjectField(TEXT("Baselines"), Baselines) && (*Baselines)->TryGetObjectField(Name, Existing)
+		&& (*Existing)->TryGetObjectField(TEXT("Tolerances"), Tolerances))
+	{
+		Baseline->SetObjectField(TEXT("Tolerances"), *Tolerances);
+	}
+
+	if (!Baselines)
+	{
+		Root->SetObjectField(TEXT("Baselines"), MakeShared<FJsonObject>());
+		Root->TryGetObjectField(TEXT("Baselines"), Baselines);
+	}
+	(*Baselines)->SetObjectField(Name, Baseline);
+}
+
+bool FRunnerPerfBaselines::Compare(const FString& Name, const FJsonObject& Report, TArray<FRunnerPerfMetricResult>& OutResults) const
+{
+	OutResults.Reset();
+
+	const TSharedPtr<FJsonObject>* Baselines = nullptr;
+	const TSharedPtr<FJsonObject>* Baseline = nullptr;
+	const TSharedPtr<FJsonObject>* Metrics = nullptr;
+	if (!Root->TryGetObjectField(TEXT("Baselines"), Baselines) || !(*Baselines)->TryGetObjectField(Name, Baseline)
+		|| !(*Baseline)->TryGetObjectField(TEXT("Metrics"), Metrics))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: no baseline named %s"), *Name);
+		return false;
+	}
+
+	// Tolerances can be overridden per file and per baseline
+	const TSharedPtr<FJsonObject>* FileTolerances = nullptr;
+	const TSharedPtr<FJsonObject>* BaselineTolerances = nullptr;
+	Root->TryGetObjectField(TEXT("Tolerances"), FileTolerances);
+	(*Baseline)->TryGetObjectField(TEXT("Tolerances"), BaselineTolerances);
+
+	int32 GatedMetrics = 0;
+	for (const RunnerPerfMetrics::FMetricDefinition& Definition : RunnerPerfMetrics::Definitions)
+	{
+		FRunnerPerfMetricResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = Definition.Name;
+		Result.Subsystem = Definition.Subsystem;
+		Result.bAttributable = Definition.bAttributable;
+		Result.Tolerance = Definition.DefaultTolerance;
+		if (FileTolerances)
+		{
+			(*FileTolerances)->TryGetNumberField(Result.Name, Result.Tolerance);
+		}
+		if (BaselineTolerances)
+		{
+			(*BaselineTolerances)->TryGetNumberField(Result.Name, Result.Tolerance);
+		}
+
+		if (!(*Metrics)->TryGetNumberField(Result.Name, Result.Baseline))
+		{
+			// Metrics added after the baseline was recorded are not gated
+			Result.bMissing = true;
+			continue;
+		}
+		++GatedMetrics;
+		if (!RunnerPerfMetrics::ReadMetric(Report, Result.Name, Result.Value))
+		{
+			// A metric the baseline has but the run did not produce is a failure, e.g. a run that died before tile 500
+			Result.bMissing = true;
+			Result.bRegressed = true;
+			continue;
+		}
+
+		Result.bRegressed = Result.Value > Result.Baseline * (1 + Result.Tolerance)
+			&& Result.Value - Result.Baseline > Definition.MinAbsoluteChange;
+	}
+
+	// A baseline without any known metric would pass every run
+	if (GatedMetrics == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: baseline %s has no metrics to compare"), *Name);
+		return false;
+	}
+	return true;
+}
+
+bool FRunnerPerfBaselines::LogResults(const FString& Name, const TArray<FRunnerPerfMetricResult>& Results)
+{
+	const FRunnerPerfMetricResult* Responsible = nullptr;
+	bool bPassed = true;
+	for (const FRunnerPerfMetricResult& Result : Results)
+	{
+		if (Result.bMissing && !Result.bRegressed)
+		{
+			continue;
+		}
+
+		if (Result.bRegressed)
+		{
+			bPassed = false;
+			if (Result.bMissing)
+			{
+				UE_LOG(LogTemp, Error, TEXT("REGRESSED %-20s missing from the report [%s]"), *Result.Name, *Result.Subsystem);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("REGRESSED %-20s %10.3f -> %10.3f (%+.1f%%, tolerance %.0f%%) [%s]"),
+					*Result.Name, Result.Baseline, Result.Value, Result.GetChange() * 100, Result.Tolerance * 100, *Result.Subsystem);
+			}
+
+			// The largest regression of a single subsystem explains the frame time regressions
+			if (Result.bAttributable && (!Responsible || Result.GetChange() > Responsible->GetChange()))
+			{
+				Responsible = &Result;
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("ok        %-20s %10.3f -> %10.3f (%+.1f%%)"), *Result.Name, Result.Baseline, Result.Value, Result.GetChange() * 100);
+		}
+	}
+
+	if (bPassed)
+	{
+		UE_LOG(LogTemp, Display, TEXT("FRunnerPerfBaselines: no regressions against %s"), *Name);
+	}
+	else if (Responsible)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: regressed against %s, most likely responsible: %s"), *Name, *Responsible->Subsystem);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: regressed against %s, no runner subsystem regressed, check engine or content cost"), *Name);
+	}
+	return bPassed;
+}
+
+TSharedPtr<FJsonObject> FRunnerPerfBaselines::LoadReport(const FString& Path)
+{
+	FString Json;
+	TSharedPtr<FJsonObject> Report;
+	if (!FFileHelper::LoadFileToString(Json, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Report))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerPerfBaselines: failed to read report %s"), *Path);
+		return nullptr;
+	}
+	return Report;
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerPerfGateCommandlet.h"
+#include "RunnerPerfBaselines.h"
+
+#include "Dom/JsonObject.h"
+
+URunnerPerfGateCommandlet::URunnerPerfGateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 URunnerPerfGateCommandlet::Main(const FString& Params)
+{
+	FString ReportPath;
+	if (!FParse::Value(*Params, TEXT("Report="), ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("RunnerPerfGate: -Report=<json path> is required"));
+		return 1;
+	}
+	const TSharedPtr<FJsonObject> Report = FRunnerPerfBaselines::LoadReport(ReportPath);
+	if (!Report)
+	{
+		return 1;
+	}
+	if (!Report->GetBoolField(TEXT("Succeeded")))
+	{
+		UE_LOG(LogTemp, Error, TEXT("RunnerPerfGate: the benchmark run failed: %s"), *Report->GetStringField(TEXT("Reason")));
+		return 1;
+	}
+
+	FString BaselineName = Report->GetStringField(TEXT("Map"));
+	FParse::Value(*Params, TEXT("Baseline="), BaselineName);
+
+	FString BaselinesPath = FRunnerPerfBaselines::GetDefaultPath();
+	FParse::Value(*Params, TEXT("Baselines="), BaselinesPath);
+
+	// Only recording may start a new baseline file, the gate fails without one
+	const bool bUpdate = FParse::Param(*Params, TEXT("Update"));
+	FRunnerPerfBaselines Baselines;
+	if (!Baselines.Load(BaselinesPath, bUpdate))
+	{
+		return 1;
+	}
+
+	if (bUpdate)
+	{
+		Baselines.SetBaseline(BaselineName, *Report);
+		if (!Baselines.Save(BaselinesPath))
+		{
+			return 1;
+		}
+		UE_LOG(LogTemp, Display, TEXT("RunnerPerfGate: stored %s as baseline %s in %s"), *ReportPath, *BaselineName, *BaselinesPath);
+		return 0;
+	}
+
+	TArray<FRunnerPerfMetricResult> Results;
+	if (!Baselines.Compare(BaselineName, *Report, Results))
+	{
+		return 1;
+	}
+	return FRunnerPerfBaselines::LogResults(BaselineName, Results) ? 0 : 1;
+}
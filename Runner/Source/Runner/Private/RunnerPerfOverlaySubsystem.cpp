@@ -0,0 +1,251 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerPerfOverlaySubsystem.h"
+#include "RunnerGameMode.h"
+#include "RunnerProfiling.h"
+#include "RunnerSignificanceSubsystem.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTileManager.h"
+#include "SRunnerPerfOverlay.h"
+
+#include "Engine/GameViewportClient.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "Widgets/Layout/SBox.h"
+
+namespace RunnerPerfOverlay
+{
+	/** Frames shown in the graph */
+	constexpr int32 GraphFrames = 240;
+
+	/** Seconds between text refreshes */
+	constexpr float RefreshInterval = 0.25f;
+
+	FAutoConsoleCommandWithWorld ToggleCommand(
+		TEXT("Runner.PerfOverlay"),
+		TEXT("Toggle the runner performance overlay"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (URunnerPerfOverlaySubsystem* Overlay = World ? World->GetSubsystem<URunnerPerfOverlaySubsystem>() : nullptr)
+			{
+				Overlay->SetVisible(!Overlay->IsVisible());
+			}
+		}));
+
+	/** Returns "Used/Window" of a tile manager */
+	FString DescribeTiles(const URunnerTileManager* TileManager)
+	{
+		if (!TileManager)
+		{
+			return TEXT("-");
+		}
+		return FString::Printf(TEXT("%d/%d"), TileManager->GetTileActors().Num(), TileManager->TilesAheadPlayer + TileManager->TilesBehindPlayer);
+	}
+
+	/** Add the live spawned objects of every spawner on the tiles, by spawner type */
+	void CountSpawnedObjects(const URunnerTileManager* TileManager, TArray<int32, TInlineAllocator<8>>& Counts)
+	{
+		if (!TileManager)
+		{
+			return;
+		}
+		for (const AActor* Tile : TileManager->GetTileActors())
+		{
+			if (!Tile)
+			{
+				continue;
+			}
+			Tile->ForEachComponent<URunnerSpawnObjectsComponent>(false, [&Counts](const URunnerSpawnObjectsComponent* Spawner)
+			{
+				Counts[static_cast<int32>(Spawner->SpawnerType)] += Spawner->GetSpawnedObjects().Num();
+			});
+		}
+	}
+}
+
+URunnerPerfOverlaySubsystem::URunnerPerfOverlaySubsystem()
+	: Data(MakeShared<FRunnerPerfOverlayData>())
+{
+}
+
+bool URunnerPerfOverlaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+bool URunnerPerfOverlaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerPerfOverlaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Data->FrameTimesMs.SetNumZeroed(RunnerPerfOverlay::GraphFrames);
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &URunnerPerfOverlaySubsystem::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &URunnerPerfOverlaySubsystem::OnPostGarbageCollect);
+}
+
+void URunnerPerfOverlaySubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	SetVisible(false);
+
+	Super::Deinitialize();
+}
+
+void URunnerPerfOverlaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("RunnerPerfOverlay")))
+	{
+		SetVisible(true);
+	}
+}
+
+TStatId URunnerPerfOverlaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerPerfOverlaySubsystem, STATGROUP_Tickables);
+}
+
+void URunnerPerfOverlaySubsystem::SetVisible(bool bInVisible)
+{
+	UGameViewportClient* GameViewport = GetWorld()->GetGameViewport();
+	if (bInVisible && !Widget && GameViewport)
+	{
+		LLM_SCOPE_BYTAG(Runner_UI);
+		Widget = SNew(SBox)
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Top)
+			.Padding(FMargin(0, 40, 10, 0))
+			.Visibility(EVisibility::HitTestInvisible)
+			[
+				SNew(SRunnerPerfOverlay)
+					.Data(Data)
+			];
+		GameViewport->AddViewportWidgetContent(Widget.ToSharedRef(), 1000);
+		RefreshTimer = 0;
+	}
+	else if (!bInVisible && Widget)
+	{
+		if (GameViewport)
+		{
+			GameViewport->RemoveViewportWidgetContent(Widget.ToSharedRef());
+		}
+		Widget.Reset();
+	}
+	bVisible = Widget.IsValid();
+}
+
+void URunnerPerfOverlaySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Track spawn work even while hidden so the first refresh is accurate
+	const int32 SpawnCalls = RunnerCost::SpawnObjects.GetCallCount();
+	const double SpawnSeconds = RunnerCost::SpawnObjects.GetTotalSeconds();
+	PeakSpawnCalls = FMath::Max(PeakSpawnCalls, SpawnCalls - LastSpawnCalls);
+	PeakSpawnSeconds = FMath::Max(PeakSpawnSeconds, SpawnSeconds - LastSpawnSeconds);
+	LastSpawnCalls = SpawnCalls;
+	LastSpawnSeconds = SpawnSeconds;
+
+	if (!bVisible)
+	{
+		return;
+	}
+
+	Data->FrameTimesMs[Data->FrameHead] = DeltaTime * 1000.0f;
+	Data->FrameHead = (Data->FrameHead + 1) % Data->FrameTimesMs.Num();
+
+	RefreshTimer -= DeltaTime;
+	if (RefreshTimer <= 0)
+	{
+		RefreshTimer = RunnerPerfOverlay::RefreshInterval;
+		RefreshLines();
+		PeakSpawnCalls = 0;
+		PeakSpawnSeconds = 0;
+	}
+}
+
+void URunnerPerfOverlaySubsystem::RefreshLines()
+{
+	float Sum = 0;
+	float Max = 0;
+	for (const float Ms : Data->FrameTimesMs)
+	{
+		Sum += Ms;
+		Max = FMath::Max(Max, Ms);
+	}
+	const float Latest = Data->FrameTimesMs[(Data->FrameHead + Data->FrameTimesMs.Num() - 1) % Data->FrameTimesMs.Num()];
+
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	const URunnerTileManager* FloorManager = MyGameMode ? MyGameMode->RunnerFloorManager.Get() : nullptr;
+	const URunnerTileManager* SkylineManager = MyGameMode ? MyGameMode->RunnerSkylineManager.Get() : nullptr;
+
+	const UEnum* SpawnerTypeEnum = StaticEnum<ERunnerSpawnerType>();
+	TArray<int32, TInlineAllocator<8>> SpawnedCounts;
+	SpawnedCounts.SetNumZeroed(SpawnerTypeEnum->NumEnums() - 1);
+	RunnerPerfOverlay::CountSpawnedObjects(FloorManager, SpawnedCounts);
+	RunnerPerfOverlay::CountSpawnedObjects(SkylineManager, SpawnedCounts);
+	FString Spawned;
+	for (int32 Index = 0; Index < SpawnedCounts.Num(); ++Index)
+	{
+		Spawned += FString::Printf(TEXT(" %s %d"), *SpawnerTypeEnum->GetNameStringByIndex(Index), SpawnedCounts[Index]);
+	}
+
+	FString Tiers;
+	if (const URunnerSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URunnerSignificanceSubsystem>())
+	{
+		const TArray<int32>& TierCounts = Significance->GetTierCounts();
+		for (int32 Index = 0; Index < TierCounts.Num() && Index < Significance->GetTiers().Num(); ++Index)
+		{
+			Tiers += FString::Printf(TEXT(" %s %d"), *Significance->GetTiers()[Index].Name.ToString(), TierCounts[Index]);
+		}
+	}
+
+	TArray<FString>& Lines = Data->Lines;
+	Lines.Reset();
+	Lines.Add(FString::Printf(TEXT("Frame     %6.2f ms  avg %6.2f  max %6.2f"), Latest, Sum / Data->FrameTimesMs.Num(), Max));
+	Lines.Add(FString::Printf(TEXT("Tiles     floor %s  skyline %s"), *RunnerPerfOverlay::DescribeTiles(FloorManager), *RunnerPerfOverlay::DescribeTiles(SkylineManager)));
+	Lines.Add(FString::Printf(TEXT("Spawn     peak %d calls  %.2f ms per frame"), PeakSpawnCalls, PeakSpawnSeconds * 1000.0));
+	Lines.Add(FString::Printf(TEXT("Live     %s  reclaimed %d"), *Spawned, FloorManager ? FloorManager->GetReclaimedCount() : 0));
+	Lines.Add(FString::Printf(TEXT("Tiers    %s"), Tiers.IsEmpty() ? TEXT(" -") : *Tiers));
+	Lines.Add(FString::Printf(TEXT("UObjects  %d"), GUObjectArray.GetObjectArrayNumMinusAvailable()));
+	Lines.Add(LastGCTime > 0
+		? FString::Printf(TEXT("Last GC   %.2f ms  %.0f s ago"), LastGCPauseSeconds * 1000.0, FPlatformTime::Seconds() - LastGCTime)
+		: FString(TEXT("Last GC   -")));
+	Lines.Add(FString::Printf(TEXT("Save I/O  %d saves  last %.2f ms  max %.2f ms (blocking)"),
+		RunnerCost::SaveGame.GetCallCount(), RunnerCost::SaveGame.GetLastSeconds() * 1000.0, RunnerCost::SaveGame.GetMaxSeconds() * 1000.0));
+
+	if (Widget)
+	{
+		Widget->Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+void URunnerPerfOverlaySubsystem::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void URunnerPerfOverlaySubsystem::OnPostGarbageCollect()
+{
+	if (GCStartTime > 0)
+	{
+		LastGCTime = FPlatformTime::Seconds();
+		LastGCPauseSeconds = LastGCTime - GCStartTime;
+	}
+	GCStartTime = 0;
+}
@@ -3,6 +3,8 @@
 
 #include "RunnerPlayerController.h"
 #include "RunnerCharacter.h"
+#include "RunnerCheatManager.h"
+#include "RunnerSimulationComponent.h"
 
 #include "EnhancedInputSubsystems.h"
 #include "Blueprint/UserWidget.h"
@@ -10,6 +12,11 @@
 #include "Components/CapsuleComponent.h"
 #include "Blueprint/UserWidget.h"
 
+ARunnerPlayerController::ARunnerPlayerController()
+{
+	CheatClass = URunnerCheatManager::StaticClass();
+}
+
 void ARunnerPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
@@ -20,7 +27,8 @@ void ARunnerPlayerController::SetupInputComponent()
 	Super::SetupInputComponent();
 
 	// Add Input Mapping Context
-	if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer()))
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer());
+	if (Subsystem && DefaultMappingContext)
 	{
 		Subsystem->AddMappingContext(DefaultMappingContext, 0);
 	}
@@ -78,6 +86,10 @@ void ARunnerPlayerController::Jump()
 	{
 		MyCharacter->Jump();
 	}
+	if (ARunnerCharacter* MyRunnerCharacter = Cast<ARunnerCharacter>(GetPawn()))
+	{
+		MyRunnerCharacter->GetSimulation()->QueueJump();
+	}
 }
 
 void ARunnerPlayerController::Slide()
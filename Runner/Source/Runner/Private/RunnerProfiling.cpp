@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerProfiling.h"
+
+#include "LoadingScreenModule.h"
+
+DEFINE_STAT(STAT_RunnerSpawnedCoins);
+DEFINE_STAT(STAT_RunnerSpawnedPowerups);
+DEFINE_STAT(STAT_RunnerSpawnedObstacles);
+DEFINE_STAT(STAT_RunnerSpawnedMovingObstacles);
+DEFINE_STAT(STAT_RunnerSpawnedScenery);
+DEFINE_STAT(STAT_RunnerSpawnedOther);
+
+UE_TRACE_CHANNEL_DEFINE(RunnerChannel);
+
+LLM_DEFINE_TAG(Runner);
+LLM_DEFINE_TAG(Runner_Tiles);
+LLM_DEFINE_TAG(Runner_Skyline);
+LLM_DEFINE_TAG(Runner_Spawned_Coins);
+LLM_DEFINE_TAG(Runner_Spawned_Powerups);
+LLM_DEFINE_TAG(Runner_Spawned_Obstacles);
+LLM_DEFINE_TAG(Runner_Spawned_MovingObstacles);
+LLM_DEFINE_TAG(Runner_Spawned_Scenery);
+LLM_DEFINE_TAG(Runner_Spawned_Other);
+LLM_DEFINE_TAG(Runner_UI);
+LLM_DEFINE_TAG(Runner_SaveGame);
+
+namespace RunnerLLM
+{
+	FName GetSpawnerTag(ERunnerSpawnerType SpawnerType)
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		switch (SpawnerType)
+		{
+		case ERunnerSpawnerType::Coin:           return LLM_TAG_NAME(Runner_Spawned_Coins);
+		case ERunnerSpawnerType::Powerup:        return LLM_TAG_NAME(Runner_Spawned_Powerups);
+		case ERunnerSpawnerType::Obstacle:       return LLM_TAG_NAME(Runner_Spawned_Obstacles);
+		case ERunnerSpawnerType::MovingObstacle: return LLM_TAG_NAME(Runner_Spawned_MovingObstacles);
+		case ERunnerSpawnerType::Scenery:        return LLM_TAG_NAME(Runner_Spawned_Scenery);
+		default:                                 return LLM_TAG_NAME(Runner_Spawned_Other);
+		}
+#else
+		return NAME_None;
+#endif
+	}
+
+	const TArray<FName>& GetAllTags()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		static const TArray<FName> Tags =
+		{
+			LLM_TAG_NAME(Runner_Tiles),
+			LLM_TAG_NAME(Runner_Skyline),
+			LLM_TAG_NAME(Runner_Spawned_Coins),
+			LLM_TAG_NAME(Runner_Spawned_Powerups),
+			LLM_TAG_NAME(Runner_Spawned_Obstacles),
+			LLM_TAG_NAME(Runner_Spawned_MovingObstacles),
+			LLM_TAG_NAME(Runner_Spawned_Scenery),
+			LLM_TAG_NAME(Runner_Spawned_Other),
+			LLM_TAG_NAME(Runner_UI),
+			LLM_TAG_NAME(Runner_SaveGame),
+			LLM_TAG_NAME(Runner_LoadingScreen),
+		};
+#else
+		static const TArray<FName> Tags;
+#endif
+		return Tags;
+	}
+
+	FString GetReportName(FName Tag)
+	{
+		return Tag.ToString().Replace(TEXT("/"), TEXT("_"));
+	}
+
+	bool IsEnabled()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		return FLowLevelMemTracker::IsEnabled();
+#else
+		return false;
+#endif
+	}
+
+	int64 GetTagAmount(FName Tag)
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, Tag, ELLMTagSet::None);
+		}
+#endif
+		return 0;
+	}
+}
+
+bool FRunnerCostCounter::bRecordSamples = false;
+
+namespace RunnerCost
+{
+	FRunnerCostCounter ExtendTile(TEXT("ExtendTile"));
+	FRunnerCostCounter AddTile(TEXT("AddTile"));
+	FRunnerCostCounter RemoveTile(TEXT("RemoveTile"));
+	FRunnerCostCounter SpawnObjects(TEXT("SpawnObjects"));
+	FRunnerCostCounter LayOutObjects(TEXT("LayOutObjects"));
+	FRunnerCostCounter SaveGame(TEXT("SaveGame"));
+	FRunnerCostCounter CreateWidget(TEXT("CreateWidget"));
+}
+
+FRunnerCostCounter::FRunnerCostCounter(const TCHAR* InName)
+	: Name(InName)
+{
+	GetRegistry().Add(this);
+}
+
+void FRunnerCostCounter::Add(double Seconds)
+{
+	++CallCount;
+	TotalSeconds += Seconds;
+	MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+	LastSeconds = Seconds;
+	if (bRecordSamples)
+	{
+		Samples.Add(static_cast<float>(Seconds * 1000.0));
+	}
+}
+
+void FRunnerCostCounter::Reset()
+{
+	CallCount = 0;
+	TotalSeconds = 0;
+	MaxSeconds = 0;
+	LastSeconds = 0;
+	Samples.Reset();
+}
+
+void FRunnerCostCounter::SetRecordSamples(bool bEnabled)
+{
+	bRecordSamples = bEnabled;
+
+	// Reserve up front so recording does not allocate during the run
+	for (FRunnerCostCounter* Counter : GetRegistry())
+	{
+		if (bEnabled)
+		{
+			Counter->Samples.Reserve(16384);
+		}
+		else
+		{
+			Counter->Samples.Empty();
+		}
+	}
+}
+
+void FRunnerCostCounter::ResetAll()
+{
+	for (FRunnerCostCounter* Counter : GetRegistry())
+	{
+		Counter->Reset();
+	}
+}
+
+const TArray<FRunnerCostCounter*>& FRunnerCostCounter::GetAll()
+{
+	return GetRegistry();
+}
+
+TArray<FRunnerCostCounter*>& FRunnerCostCounter::GetRegistry()
+{
+	// Function local so counters in other translation units can register during static initialization
+	static TArray<FRunnerCostCounter*> Registry;
+	return Registry;
+}
@@ -5,6 +5,21 @@
 
 #include "RunnerGameInstance.h"
 
+URunnerScoreManager::URunnerScoreManager()
+{
+	// Tick only runs on frames with pending changes
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void URunnerScoreManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushChanges();
+}
+
 void URunnerScoreManager::BeginPlay()
 {
 	Super::BeginPlay();
@@ -24,11 +39,15 @@ void URunnerScoreManager::BeginPlay()
 void URunnerScoreManager::AddScore(int32 Value)
 {
 	CurrentScore += Value;
+	PendingScoreDelta += Value;
+	MarkDirty();
 }
 
 void URunnerScoreManager::AddCoins(int32 Value)
 {
 	CurrentCoins += Value;
+	PendingCoinsDelta += Value;
+	MarkDirty();
 }
 
 void URunnerScoreManager::SaveHighScore()
@@ -41,6 +60,13 @@ void URunnerScoreManager::SaveHighScore()
 			MyGameInstance->SetHighScoreToSaveGame(CurrentScore);
 		}
 	}
+
+	if (CurrentScore > HighScore)
+	{
+		PendingHighScoreDelta += CurrentScore - HighScore;
+		HighScore = CurrentScore;
+		MarkDirty();
+	}
 }
 
 void URunnerScoreManager::SaveTotalCoin()
@@ -51,3 +77,36 @@ void URunnerScoreManager::SaveTotalCoin()
 		MyGameInstance->SetTotalCoinsToSaveGame(CurrentCoins);
 	}
 }
+
+void URunnerScoreManager::MarkDirty()
+{
+	if (!IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void URunnerScoreManager::FlushChanges()
+{
+	// Clear pending values before broadcasting so listeners may change the score again
+	const int32 ScoreDelta = PendingScoreDelta;
+	const int32 CoinsDelta = PendingCoinsDelta;
+	const int32 HighScoreDelta = PendingHighScoreDelta;
+	PendingScoreDelta = 0;
+	PendingCoinsDelta = 0;
+	PendingHighScoreDelta = 0;
+	SetComponentTickEnabled(false);
+
+	if (ScoreDelta != 0)
+	{
+		OnScoreChanged.Broadcast(CurrentScore, ScoreDelta);
+	}
+	if (CoinsDelta != 0)
+	{
+		OnCoinsChanged.Broadcast(CurrentCoins, CoinsDelta);
+	}
+	if (HighScoreDelta != 0)
+	{
+		OnHighScoreChanged.Broadcast(HighScore, HighScoreDelta);
+	}
+}
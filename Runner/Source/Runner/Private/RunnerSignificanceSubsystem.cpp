@@ -0,0 +1,296 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSignificanceSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace RunnerSignificance
+{
+	/** Returns the distance of the location along the track from the player, tiles are laid out along X */
+	float GetTrackDistance(const FVector& Location, const FVector& PlayerLocation)
+	{
+		return Location.X - PlayerLocation.X;
+	}
+
+#if !UE_BUILD_SHIPPING
+	FAutoConsoleCommandWithWorld LogCommand(
+		TEXT("Runner.Significance"),
+		TEXT("Log the spawned objects per significance tier"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const URunnerSignificanceSubsystem* SignificanceSubsystem = World ? World->GetSubsystem<URunnerSignificanceSubsystem>() : nullptr)
+			{
+				SignificanceSubsystem->LogTiers();
+			}
+		}));
+#endif
+}
+
+bool URunnerSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const URunnerSignificanceSettings* Settings = GetDefault<URunnerSignificanceSettings>();
+	Tiers = Settings->Tiers;
+	UpdateInterval = Settings->UpdateInterval;
+	TierCounts.Init(0, Tiers.Num());
+}
+
+TStatId URunnerSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void URunnerSignificanceSubsystem::Register(AActor* Actor, ERunnerSpawnerType SpawnerType)
+{
+	if (!Actor || Tiers.Num() == 0)
+	{
+		return;
+	}
+
+	FSignificanceEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.SpawnerType = SpawnerType;
+	Entry.bTickEnabled = Actor->IsActorTickEnabled();
+	Entry.TickInterval = Actor->GetActorTickInterval();
+	Entry.bCollision = Actor->GetActorEnableCollision();
+	Entry.bHidden = Actor->IsHidden();
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component);
+		const bool bCastShadow = Primitive && Primitive->CastShadow;
+		if (!Component || (!Component->PrimaryComponentTick.bCanEverTick && !bCastShadow))
+		{
+			continue;
+		}
+
+		FComponentState& State = Entry.Components.AddDefaulted_GetRef();
+		State.Component = Component;
+		State.bAnimation = Component->IsA<USkinnedMeshComponent>();
+		State.bTickEnabled = Component->IsComponentTickEnabled();
+		State.TickInterval = Component->GetComponentTickInterval();
+		State.bCastShadow = bCastShadow;
+	}
+
+	// Objects usually spawn far ahead, reduce them right away instead of on the next update
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (const APawn* Player = PlayerController ? PlayerController->GetPawn() : nullptr)
+	{
+		Entry.Distance = RunnerSignificance::GetTrackDistance(Actor->GetActorLocation(), Player->GetActorLocation());
+		Entry.Tier = FindDistanceTier(Tiers, Entry.Distance);
+		ApplyTier(Entry, Tiers[Entry.Tier]);
+	}
+}
+
+void URunnerSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Tiers.Num() == 0)
+	{
+		return;
+	}
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate <= 0)
+	{
+		TimeUntilUpdate = UpdateInterval;
+		UpdateTiers();
+	}
+}
+
+bool URunnerSignificanceSubsystem::RefreshTier(AActor* Actor)
+{
+	FSignificanceEntry* Entry = Entries.FindByPredicate([Actor](const FSignificanceEntry& Candidate) { return Candidate.Actor.Get() == Actor; });
+	if (!Entry || !Tiers.IsValidIndex(Entry->Tier))
+	{
+		return false;
+	}
+	ApplyTier(*Entry, Tiers[Entry->Tier]);
+	return true;
+}
+
+int32 URunnerSignificanceSubsystem::FindDistanceTier(TConstArrayView<FRunnerSignificanceTier> InTiers, float Distance)
+{
+	const int32 Index = InTiers.IndexOfByPredicate([Distance](const FRunnerSignificanceTier& Tier)
+	{
+		return Distance >= Tier.MinDistance && Distance <= Tier.MaxDistance;
+	});
+	return Index != INDEX_NONE ? Index : InTiers.Num() - 1;
+}
+
+int32 URunnerSignificanceSubsystem::FindOverflowTier(TConstArrayView<FRunnerSignificanceTier> InTiers, int32 Tier, float Distance)
+{
+	// Objects ahead overflow to tiers farther ahead and objects behind to tiers farther behind,
+	// so a full tier ahead of the player never pushes objects into a tier meant for passed ones
+	const FRunnerSignificanceTier& Full = InTiers[Tier];
+	for (int32 Index = Tier + 1; Index < InTiers.Num(); ++Index)
+	{
+		const bool bFarther = Distance >= 0 ? InTiers[Index].MaxDistance > Full.MaxDistance : InTiers[Index].MinDistance < Full.MinDistance;
+		if (bFarther)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void URunnerSignificanceSubsystem::AssignTiers(TConstArrayView<FRunnerSignificanceTier> InTiers, TConstArrayView<float> Distances,
+	TArray<int32>& SortScratch, TArray<int32>& OutTiers, TArray<int32>& OutTierCounts)
+{
+	OutTierCounts.Init(0, InTiers.Num());
+	OutTiers.Reset();
+	SortScratch.Reset();
+	if (InTiers.Num() == 0)
+	{
+		return;
+	}
+
+	// Tiers by distance first, the most significant objects are then placed first
+	for (int32 Index = 0; Index < Distances.Num(); ++Index)
+	{
+		OutTiers.Add(FindDistanceTier(InTiers, Distances[Index]));
+		SortScratch.Add(Index);
+	}
+	SortScratch.Sort([&OutTiers, &Distances](int32 A, int32 B)
+	{
+		if (OutTiers[A] != OutTiers[B])
+		{
+			return OutTiers[A] < OutTiers[B];
+		}
+		return FMath::Abs(Distances[A]) < FMath::Abs(Distances[B]);
+	});
+
+	for (const int32 Index : SortScratch)
+	{
+		int32 Tier = OutTiers[Index];
+		while (InTiers[Tier].MaxObjects > 0 && OutTierCounts[Tier] >= InTiers[Tier].MaxObjects)
+		{
+			const int32 OverflowTier = FindOverflowTier(InTiers, Tier, Distances[Index]);
+			if (OverflowTier == INDEX_NONE)
+			{
+				break;
+			}
+			Tier = OverflowTier;
+		}
+		OutTiers[Index] = Tier;
+		++OutTierCounts[Tier];
+	}
+}
+
+void URunnerSignificanceSubsystem::UpdateTiers()
+{
+	// Objects keep their tiers while there is no player, e.g. on the game over screen
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APawn* Player = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (!Player)
+	{
+		return;
+	}
+	const FVector PlayerLocation = Player->GetActorLocation();
+
+	// Drop the objects destroyed with their tiles
+	Entries.RemoveAllSwap([](const FSignificanceEntry& Entry) { return !Entry.Actor.IsValid(); }, EAllowShrinking::No);
+	EntryDistances.Reset();
+	for (FSignificanceEntry& Entry : Entries)
+	{
+		Entry.Distance = RunnerSignificance::GetTrackDistance(Entry.Actor->GetActorLocation(), PlayerLocation);
+		EntryDistances.Add(Entry.Distance);
+	}
+
+	AssignTiers(Tiers, EntryDistances, SortedEntries, AssignedTiers, TierCounts);
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		FSignificanceEntry& Entry = Entries[Index];
+		if (AssignedTiers[Index] != Entry.Tier)
+		{
+			Entry.Tier = AssignedTiers[Index];
+			ApplyTier(Entry, Tiers[Entry.Tier]);
+		}
+	}
+}
+
+void URunnerSignificanceSubsystem::ApplyTier(FSignificanceEntry& Entry, const FRunnerSignificanceTier& Tier) const
+{
+	AActor* Actor = Entry.Actor.Get();
+	if (!Actor)
+	{
+		return;
+	}
+
+	// Throttling never makes an object tick more often than it was registered with
+	if (Actor->PrimaryActorTick.bCanEverTick)
+	{
+		Actor->SetActorTickEnabled(Entry.bTickEnabled && Tier.TickMode != ERunnerTickMode::Disable);
+		Actor->SetActorTickInterval(Tier.TickMode == ERunnerTickMode::Throttle ? FMath::Max(Entry.TickInterval, Tier.TickInterval) : Entry.TickInterval);
+	}
+
+	for (const FComponentState& State : Entry.Components)
+	{
+		UActorComponent* Component = State.Component.Get();
+		if (!Component)
+		{
+			continue;
+		}
+
+		if (Component->PrimaryComponentTick.bCanEverTick)
+		{
+			const ERunnerTickMode Mode = State.bAnimation ? Tier.AnimationMode : Tier.TickMode;
+			const float Interval = State.bAnimation ? Tier.AnimationInterval : Tier.TickInterval;
+			Component->SetComponentTickEnabled(State.bTickEnabled && Mode != ERunnerTickMode::Disable);
+			Component->SetComponentTickInterval(Mode == ERunnerTickMode::Throttle ? FMath::Max(State.TickInterval, Interval) : State.TickInterval);
+		}
+
+		if (State.bCastShadow)
+		{
+			CastChecked<UPrimitiveComponent>(Component)->SetCastShadow(Tier.bCastShadows);
+		}
+	}
+
+	Actor->SetActorEnableCollision(Entry.bCollision && Tier.bCollision);
+	Actor->SetActorHiddenInGame(Entry.bHidden || !Tier.bVisible);
+}
+
+#if !UE_BUILD_SHIPPING
+void URunnerSignificanceSubsystem::LogTiers() const
+{
+	UE_LOG(LogTemp, Display, TEXT("URunnerSignificanceSubsystem: %d objects in %d tiers"), Entries.Num(), Tiers.Num());
+	for (int32 TierIndex = 0; TierIndex < Tiers.Num(); ++TierIndex)
+	{
+		// Objects per spawner type, indexed by the enum value
+		TArray<int32, TInlineAllocator<8>> TypeCounts;
+		TypeCounts.SetNumZeroed(static_cast<int32>(ERunnerSpawnerType::Scenery) + 1);
+		for (const FSignificanceEntry& Entry : Entries)
+		{
+			if (Entry.Tier == TierIndex)
+			{
+				++TypeCounts[static_cast<int32>(Entry.SpawnerType)];
+			}
+		}
+
+		FString TypeSummary;
+		for (int32 TypeIndex = 0; TypeIndex < TypeCounts.Num(); ++TypeIndex)
+		{
+			if (TypeCounts[TypeIndex] > 0)
+			{
+				TypeSummary += FString::Printf(TEXT(" %s=%d"), *UEnum::GetDisplayValueAsText(static_cast<ERunnerSpawnerType>(TypeIndex)).ToString(), TypeCounts[TypeIndex]);
+			}
+		}
+
+		const FRunnerSignificanceTier& Tier = Tiers[TierIndex];
+		UE_LOG(LogTemp, Display, TEXT("  %-10s [%7.0f, %7.0f] %4d objects (budget %d)%s"),
+			*Tier.Name.ToString(), Tier.MinDistance, Tier.MaxDistance, TierCounts.IsValidIndex(TierIndex) ? TierCounts[TierIndex] : 0, Tier.MaxObjects, *TypeSummary);
+	}
+}
+#endif
@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSimulation.h"
+
+FRunnerSimulation::FRunnerSimulation(const FRunnerSimConfig& InConfig)
+{
+	Reset(InConfig);
+}
+
+void FRunnerSimulation::Reset(const FRunnerSimConfig& InConfig)
+{
+	Config = InConfig;
+	StepSeconds = 1.0f / FMath::Max(Config.StepRate, 1);
+	RandomStream.Initialize(Config.Seed);
+
+	State = FRunnerSimState();
+	State.Speed = Config.StartSpeed;
+	SetLane(Config.StartLaneIndex);
+}
+
+FRunnerSimEvents FRunnerSimulation::Step(const FRunnerSimInput& Input)
+{
+	FRunnerSimEvents Events;
+	++State.StepCount;
+
+	if (State.bIsDead)
+	{
+		return Events;
+	}
+
+	// Apply commands
+	if (Input.LaneOffset != 0 && !State.IsSwitchingLane() && Config.LaneYOffsets.Num() > 0)
+	{
+		const int32 NewIndex = FMath::Clamp(State.LaneIndex + Input.LaneOffset, 0, Config.LaneYOffsets.Num() - 1);
+		if (NewIndex != State.LaneIndex)
+		{
+			State.TargetLaneIndex = NewIndex;
+			State.LaneSwitchAlpha = 0;
+		}
+	}
+	if (Input.bSlide && !State.IsSliding())
+	{
+		State.SlideTimeRemaining = Config.SlideDuration;
+	}
+	if (Input.bJump && !State.IsAirborne())
+	{
+		State.AirTimeRemaining = Config.JumpDuration;
+	}
+	if (Input.bMagnet)
+	{
+		State.MagnetTimeRemaining = Config.MagnetDuration;
+	}
+	for (int32 i = 0; i < Input.TilesPassed; ++i)
+	{
+		PassTile(Input.TileSpeedIncrement, Input.TileMaxSpeed);
+		++Events.TilesPassed;
+	}
+
+	// Move along the track
+	State.TrackPosition += static_cast<double>(State.Speed) * StepSeconds;
+	if (Config.TileLength > 0)
+	{
+		const int32 TrackTileIndex = FMath::FloorToInt32(State.TrackPosition / Config.TileLength);
+		while (State.TileIndex < TrackTileIndex)
+		{
+			PassTile(Config.SpeedIncrement, Config.MaxSpeed);
+			++Events.TilesPassed;
+		}
+	}
+
+	// Move between lanes
+	if (State.IsSwitchingLane())
+	{
+		State.LaneSwitchAlpha = Config.LaneSwitchDuration > 0 ? State.LaneSwitchAlpha + StepSeconds / Config.LaneSwitchDuration : 1;
+		if (State.LaneSwitchAlpha >= 1)
+		{
+			State.LaneSwitchAlpha = 1;
+			State.LaneIndex = State.TargetLaneIndex;
+			Events.bLaneSwitchFinished = true;
+		}
+	}
+	State.LateralPosition = FMath::Lerp(GetLaneY(State.LaneIndex), GetLaneY(State.TargetLaneIndex), State.LaneSwitchAlpha);
+
+	// Count down effects
+	Events.bSlideEnded = TickTimer(State.SlideTimeRemaining, StepSeconds);
+	Events.bJumpEnded = TickTimer(State.AirTimeRemaining, StepSeconds);
+	Events.bMagnetEnded = TickTimer(State.MagnetTimeRemaining, StepSeconds);
+
+	return Events;
+}
+
+void FRunnerSimulation::SetLane(int32 InLaneIndex)
+{
+	State.LaneIndex = Config.LaneYOffsets.Num() > 0 ? FMath::Clamp(InLaneIndex, 0, Config.LaneYOffsets.Num() - 1) : 0;
+	State.TargetLaneIndex = State.LaneIndex;
+	State.LaneSwitchAlpha = 1;
+	State.LateralPosition = GetLaneY(State.LaneIndex);
+}
+
+void FRunnerSimulation::SetTileSpeed(float InSpeedIncrement, float InMaxSpeed)
+{
+	Config.SpeedIncrement = InSpeedIncrement;
+	Config.MaxSpeed = InMaxSpeed;
+}
+
+float FRunnerSimulation::GetLaneY(int32 InLaneIndex) const
+{
+	return Config.LaneYOffsets.IsValidIndex(InLaneIndex) ? Config.LaneYOffsets[InLaneIndex] : 0;
+}
+
+void FRunnerSimulation::PassTile(float Increment, float Max)
+{
+	++State.TileIndex;
+	State.Speed = FMath::Min(State.Speed + Increment, Max);
+}
+
+bool FRunnerSimulation::TickTimer(float& TimeRemaining, float DeltaSeconds)
+{
+	if (TimeRemaining <= 0)
+	{
+		return false;
+	}
+
+	TimeRemaining -= DeltaSeconds;
+	if (TimeRemaining <= 0)
+	{
+		TimeRemaining = 0;
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSimulationComponent.h"
+
+#include "Curves/CurveFloat.h"
+
+URunnerSimulationComponent::URunnerSimulationComponent()
+{
+	// The owner advances the simulation from its own tick
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void URunnerSimulationComponent::ResetSimulation()
+{
+	Simulation.Reset(Config);
+	PreviousState = Simulation.GetState();
+	PendingInput.Reset();
+	Accumulator = 0;
+}
+
+FRunnerSimEvents URunnerSimulationComponent::Advance(float DeltaTime)
+{
+	FRunnerSimEvents Events;
+	const float StepSeconds = Simulation.GetStepSeconds();
+	Accumulator += DeltaTime;
+
+	int32 Steps = 0;
+	while (Accumulator >= StepSeconds && Steps < Config.MaxStepsPerFrame)
+	{
+		PreviousState = Simulation.GetState();
+		Events |= Simulation.Step(PendingInput);
+		PendingInput.Reset();
+		Accumulator -= StepSeconds;
+		++Steps;
+	}
+
+	// Drop the time that could not be simulated this frame
+	if (Steps == Config.MaxStepsPerFrame)
+	{
+		Accumulator = FMath::Min(Accumulator, StepSeconds);
+	}
+
+	return Events;
+}
+
+void URunnerSimulationComponent::QueueLaneSwitch(int32 LaneOffset)
+{
+	PendingInput.LaneOffset = LaneOffset;
+}
+
+void URunnerSimulationComponent::QueueSlide()
+{
+	PendingInput.bSlide = true;
+}
+
+void URunnerSimulationComponent::QueueJump()
+{
+	PendingInput.bJump = true;
+}
+
+void URunnerSimulationComponent::QueueMagnet()
+{
+	PendingInput.bMagnet = true;
+}
+
+void URunnerSimulationComponent::QueueTilePassed(float SpeedIncrement, float MaxSpeed)
+{
+	++PendingInput.TilesPassed;
+	PendingInput.TileSpeedIncrement = SpeedIncrement;
+	PendingInput.TileMaxSpeed = MaxSpeed;
+}
+
+void URunnerSimulationComponent::SetTileSpeed(float SpeedIncrement, float MaxSpeed)
+{
+	Config.SpeedIncrement = SpeedIncrement;
+	Config.MaxSpeed = MaxSpeed;
+	Simulation.SetTileSpeed(SpeedIncrement, MaxSpeed);
+}
+
+void URunnerSimulationComponent::SetLane(int32 LaneIndex)
+{
+	Simulation.SetLane(LaneIndex);
+	PreviousState = Simulation.GetState();
+}
+
+void URunnerSimulationComponent::SetDead(bool bIsDead)
+{
+	Simulation.SetDead(bIsDead);
+}
+
+float URunnerSimulationComponent::GetInterpolationAlpha() const
+{
+	return FMath::Clamp(Accumulator / Simulation.GetStepSeconds(), 0.0f, 1.0f);
+}
+
+float URunnerSimulationComponent::GetInterpolatedLateralPosition(const UCurveFloat* LaneSwitchCurve) const
+{
+	const FRunnerSimState& State = Simulation.GetState();
+	if (!State.IsSwitchingLane() && !PreviousState.IsSwitchingLane())
+	{
+		return State.LateralPosition;
+	}
+
+	// Interpolate the progress of the switch that is running in the last step
+	const int32 FromLane = State.IsSwitchingLane() ? State.LaneIndex : PreviousState.LaneIndex;
+	const int32 ToLane = State.TargetLaneIndex;
+	const float PreviousAlpha = PreviousState.TargetLaneIndex == ToLane ? PreviousState.LaneSwitchAlpha : 0.0f;
+	float Alpha = FMath::Lerp(PreviousAlpha, State.LaneSwitchAlpha, GetInterpolationAlpha());
+	if (LaneSwitchCurve)
+	{
+		Alpha = LaneSwitchCurve->GetFloatValue(Alpha);
+	}
+	return FMath::Lerp(Simulation.GetLaneY(FromLane), Simulation.GetLaneY(ToLane), Alpha);
+}
+
+float URunnerSimulationComponent::GetInterpolatedSpeed() const
+{
+	return FMath::Lerp(PreviousState.Speed, Simulation.GetState().Speed, GetInterpolationAlpha());
+}
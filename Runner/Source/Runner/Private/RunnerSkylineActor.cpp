@@ -5,15 +5,19 @@
 
 #include "RunnerCharacter.h"
 #include "RunnerGameMode.h"
+#include "RunnerProfiling.h"
 #include "RunnerSpawnObjectsComponent.h"
 #include "RunnerTileManager.h"
 #include "Components/ArrowComponent.h"
 #include "Components/BoxComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Skyline HandleBoxCollision"), STAT_RunnerSkylineHandleBoxCollision, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("Skyline SpawnAllObjects"), STAT_RunnerSkylineSpawnAllObjects, STATGROUP_Runner);
+
 // Sets default values
 ARunnerSkylineActor::ARunnerSkylineActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	Scene = CreateDefaultSubobject<USceneComponent>("Scene");
 	RootComponent = Scene;
@@ -35,15 +39,19 @@ ARunnerSkylineActor::ARunnerSkylineActor()
 
 	// Create and assign default value for buildings on the left
 	LeftSpawner1 = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("LeftSpawner1"));
+	LeftSpawner1->SpawnerType = ERunnerSpawnerType::Scenery;
 	
 	// Create and assign default value for trees on the left
 	LeftSpawner2 = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("LeftSpawner2"));
+	LeftSpawner2->SpawnerType = ERunnerSpawnerType::Scenery;
 	
 	// Create and assign default value for buildings on the right
 	RightSpawner1 = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("RightSpawner1"));
+	RightSpawner1->SpawnerType = ERunnerSpawnerType::Scenery;
 	
 	// Create and assign default value for trees on the right
 	RightSpawner2 = CreateDefaultSubobject<URunnerSpawnObjectsComponent>(TEXT("RightSpawner2"));
+	RightSpawner2->SpawnerType = ERunnerSpawnerType::Scenery;
 }
 
 void ARunnerSkylineActor::OnConstruction(const FTransform& Transform)
@@ -76,6 +84,8 @@ FVector ARunnerSkylineActor::GetAttachLocation_Implementation() const
 
 void ARunnerSkylineActor::HandleBoxCollision_Implementation(AActor* OverlappingActor)
 {
+	RUNNER_SCOPE_CYCLE(STAT_RunnerSkylineHandleBoxCollision);
+
 	// Check if the overlapping actor is the player
 	ARunnerCharacter* MyCharacter = Cast<ARunnerCharacter>(OverlappingActor);
 	if (!MyCharacter)
@@ -97,15 +107,24 @@ void ARunnerSkylineActor::HandleBoxCollision_Implementation(AActor* OverlappingA
 
 void ARunnerSkylineActor::SpawnAllObjects()
 {
+	RUNNER_SCOPE_CYCLE(STAT_RunnerSkylineSpawnAllObjects);
+
+	// Use the layout stream of the skyline manager in game, a random one in the editor
+	ARunnerGameMode* MyGameMode = GetWorld() ? Cast<ARunnerGameMode>(GetWorld()->GetAuthGameMode()) : nullptr;
+	const FRandomStream EditorRandomStream(FMath::Rand());
+	const FRandomStream& RandomStream = (MyGameMode && MyGameMode->RunnerSkylineManager)
+		? MyGameMode->RunnerSkylineManager->GetRandomStream()
+		: EditorRandomStream;
+
 	if (LeftGround)
 	{
-		LeftSpawner1->SpawnObjects(LeftGround);
-		LeftSpawner2->SpawnObjects(LeftGround);
+		LeftSpawner1->SpawnObjects(LeftGround, RandomStream);
+		LeftSpawner2->SpawnObjects(LeftGround, RandomStream);
 	}
 	if (RightGround)
 	{
-		RightSpawner1->SpawnObjects(RightGround);
-		RightSpawner2->SpawnObjects(RightGround);
+		RightSpawner1->SpawnObjects(RightGround, RandomStream);
+		RightSpawner2->SpawnObjects(RightGround, RandomStream);
 	}
 }
 
@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSoakSubsystem.h"
+#include "RunnerCharacter.h"
+#include "RunnerSimulationComponent.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectIterator.h"
+
+namespace RunnerSoak
+{
+	/** Samples skipped before checking growth, pools and caches fill up during the first tiles */
+	constexpr int32 WarmupSamples = 2;
+
+	/** Share of sample steps that must not decrease for a series to count as growing */
+	constexpr double MonotonicShare = 0.8;
+
+	/** Tolerances of the checked series */
+	constexpr double ClassTolerance = 20;
+	constexpr double ClassRelativeTolerance = 0.10;
+	constexpr double UObjectTolerance = 200;
+	constexpr double UObjectRelativeTolerance = 0.02;
+	constexpr double MemoryToleranceMB = 64;
+	constexpr double MemoryRelativeTolerance = 0.05;
+}
+
+bool URunnerSoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("RunnerSoak")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool URunnerSoakSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerSoakSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("SoakDuration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("SoakSampleTiles="), SampleTiles);
+	FParse::Value(CommandLine, TEXT("SoakDeathTiles="), DeathTiles);
+	SampleTiles = FMath::Max(SampleTiles, 1);
+	if (!FParse::Value(CommandLine, TEXT("SoakReport="), ReportPath))
+	{
+		ReportPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / FString::Printf(TEXT("RunnerSoak-%s.csv"), *FDateTime::Now().ToString());
+	}
+}
+
+void URunnerSoakSubsystem::Deinitialize()
+{
+	if (bStarted && !bFinished)
+	{
+		UE_LOG(LogTemp, Error, TEXT("URunnerSoakSubsystem: world was torn down after %d samples, the soak did not finish"), Samples.Num());
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId URunnerSoakSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerSoakSubsystem, STATGROUP_Tickables);
+}
+
+void URunnerSoakSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (!MyCharacter || !MyCharacter->GetSimulation())
+	{
+		return;
+	}
+	const int32 TileIndex = MyCharacter->GetSimulation()->GetState().TileIndex;
+
+	if (!bStarted)
+	{
+		bStarted = true;
+		StartTime = FPlatformTime::Seconds();
+		StartTileIndex = TileIndex;
+		NextSampleTile = SampleTiles;
+		UE_LOG(LogTemp, Display, TEXT("URunnerSoakSubsystem: started, running %.0fs with a death every %d tiles"), DurationSeconds, DeathTiles);
+		return;
+	}
+
+	const int32 Tiles = TileIndex - StartTileIndex;
+	if (MyCharacter->bIsDead && !bWasDead)
+	{
+		++Deaths;
+		LastDeathTile = Tiles;
+	}
+	bWasDead = MyCharacter->bIsDead;
+
+	// Force the death and resume cycle when the autopilot survives
+	if (DeathTiles > 0 && !MyCharacter->bIsDead && Tiles - LastDeathTile >= DeathTiles)
+	{
+		MyCharacter->PlayerDeath();
+	}
+
+	if (Tiles >= NextSampleTile)
+	{
+		TakeSample(Tiles);
+		NextSampleTile += SampleTiles;
+	}
+
+	if (FPlatformTime::Seconds() - StartTime >= DurationSeconds)
+	{
+		Finish();
+	}
+}
+
+void URunnerSoakSubsystem::TakeSample(int32 Tile)
+{
+	// Collect first so only live objects are counted
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	FSoakSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.Tile = Tile;
+	Sample.Seconds = FPlatformTime::Seconds() - StartTime;
+	Sample.Deaths = Deaths;
+	Sample.UObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Sample.UsedPhysicalMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		Sample.ClassCounts.FindOrAdd(It->GetClass()->GetFName())++;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerSoakSubsystem: tile %d, %d deaths, %d UObjects, %.0f MB"), Tile, Deaths, Sample.UObjects, Sample.UsedPhysicalMB);
+}
+
+bool URunnerSoakSubsystem::IsGrowing(const TArray<double>& Series, double AbsoluteTolerance, double RelativeTolerance, double& OutGrowth)
+{
+	OutGrowth = 0;
+	const int32 Count = Series.Num();
+	if (Count < 3)
+	{
+		return false;
+	}
+
+	// Growth over the run from a least squares fit, so single spikes do not count
+	double SumX = 0, SumY = 0, SumXY = 0, SumXX = 0;
+	int32 NonDecreasingSteps = 0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		SumX += Index;
+		SumY += Series[Index];
+		SumXY += Index * Series[Index];
+		SumXX += Index * Index;
+		if (Index > 0 && Series[Index] >= Series[Index - 1])
+		{
+			++NonDecreasingSteps;
+		}
+	}
+	const double Slope = (Count * SumXY - SumX * SumY) / (Count * SumXX - SumX * SumX);
+	const double Start = (SumY - Slope * SumX) / Count;
+	OutGrowth = Slope * (Count - 1);
+
+	const bool bSteady = NonDecreasingSteps >= RunnerSoak::MonotonicShare * (Count - 1);
+	return bSteady && OutGrowth > FMath::Max(AbsoluteTolerance, RelativeTolerance * FMath::Abs(Start));
+}
+
+void URunnerSoakSubsystem::Finish()
+{
+	bFinished = true;
+
+	// Every class seen in any sample, missing entries count as zero
+	TArray<FName> Classes;
+	for (const FSoakSample& Sample : Samples)
+	{
+		for (const TPair<FName, int32>& ClassCount : Sample.ClassCounts)
+		{
+			Classes.AddUnique(ClassCount.Key);
+		}
+	}
+	Classes.Sort(FNameLexicalLess());
+
+	// Write the samples, one row per sample and one column per class
+	TArray<FString> Lines;
+	FString Header = TEXT("Tile,Seconds,Deaths,UObjects,UsedPhysicalMB");
+	for (const FName Class : Classes)
+	{
+		Header += TEXT(",") + Class.ToString();
+	}
+	Lines.Add(Header);
+	for (const FSoakSample& Sample : Samples)
+	{
+		FString Line = FString::Printf(TEXT("%d,%.1f,%d,%d,%.1f"), Sample.Tile, Sample.Seconds, Sample.Deaths, Sample.UObjects, Sample.UsedPhysicalMB);
+		for (const FName Class : Classes)
+		{
+			Line += FString::Printf(TEXT(",%d"), Sample.ClassCounts.FindRef(Class));
+		}
+		Lines.Add(Line);
+	}
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("URunnerSoakSubsystem: failed to write %s"), *ReportPath);
+	}
+
+	// Check the samples after the warm-up for steady growth
+	bool bLeaked = false;
+	const int32 First = FMath::Min(RunnerSoak::WarmupSamples, Samples.Num());
+	auto Check = [this, First, &bLeaked](const FString& Name, TFunctionRef<double(const FSoakSample&)> GetValue, double AbsoluteTolerance, double RelativeTolerance)
+	{
+		TArray<double> Series;
+		for (int32 Index = First; Index < Samples.Num(); ++Index)
+		{
+			Series.Add(GetValue(Samples[Index]));
+		}
+		double Growth = 0;
+		if (IsGrowing(Series, AbsoluteTolerance, RelativeTolerance, Growth))
+		{
+			bLeaked = true;
+			UE_LOG(LogTemp, Error, TEXT("URunnerSoakSubsystem: LEAK %s grew by %.1f over %d samples"), *Name, Growth, Series.Num());
+		}
+	};
+	Check(TEXT("UObjects"), [](const FSoakSample& Sample) { return double(Sample.UObjects); }, RunnerSoak::UObjectTolerance, RunnerSoak::UObjectRelativeTolerance);
+	Check(TEXT("UsedPhysicalMB"), [](const FSoakSample& Sample) { return Sample.UsedPhysicalMB; }, RunnerSoak::MemoryToleranceMB, RunnerSoak::MemoryRelativeTolerance);
+	for (const FName Class : Classes)
+	{
+		Check(Class.ToString(), [Class](const FSoakSample& Sample) { return double(Sample.ClassCounts.FindRef(Class)); }, RunnerSoak::ClassTolerance, RunnerSoak::ClassRelativeTolerance);
+	}
+
+	const bool bSucceeded = !bLeaked && Samples.Num() - First >= 3;
+	if (Samples.Num() - First < 3)
+	{
+		UE_LOG(LogTemp, Error, TEXT("URunnerSoakSubsystem: only %d samples after the warm-up, run longer or sample more often"), Samples.Num() - First);
+	}
+	UE_LOG(LogTemp, Display, TEXT("URunnerSoakSubsystem: %s after %d deaths and %d samples, report written to %s"),
+		bSucceeded ? TEXT("succeeded") : TEXT("failed"), Deaths, Samples.Num(), *ReportPath);
+
+	FPlatformMisc::RequestExitWithStatus(false, bSucceeded ? 0 : 1);
+}
@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSpawnAllocCommandlet.h"
+
+#include "RunnerFloorActor.h"
+#include "RunnerGameMode.h"
+#include "RunnerSpawnLayout.h"
+#include "RunnerSpawnPolicies.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTileManager.h"
+#include "Components/ArrowComponent.h"
+#include "GameMapsSettings.h"
+
+namespace RunnerSpawnAlloc
+{
+	/** Forwards to the engine allocator and counts the allocations made on the game thread */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("RunnerCountingMalloc");
+		}
+
+		int32 GetCount() const { return Count; }
+
+		void ResetCount() { Count = 0; }
+
+	private:
+		FMalloc* Inner;
+
+		/** Only changed on the game thread */
+		int32 Count = 0;
+
+		void CountAllocation()
+		{
+			if (IsInGameThread())
+			{
+				++Count;
+			}
+		}
+	};
+
+	/**
+	 *  Returns the counting allocator, wrapping the engine allocator of the first call.
+	 *  It outlives every count, other threads may still call it after GMalloc is restored.
+	 */
+	FCountingMalloc& GetCountingMalloc()
+	{
+		static FCountingMalloc CountingMalloc(GMalloc);
+		return CountingMalloc;
+	}
+
+	/** Load the floor tile defaults, from -TileClass or from the tile manager of the default game mode */
+	const ARunnerFloorActor* LoadFloorDefaults(const FString& Params)
+	{
+		FString TileClassPath;
+		if (FParse::Value(*Params, TEXT("TileClass="), TileClassPath))
+		{
+			const UClass* TileClass = LoadObject<UClass>(nullptr, *TileClassPath);
+			return TileClass && TileClass->IsChildOf(ARunnerFloorActor::StaticClass()) ? TileClass->GetDefaultObject<ARunnerFloorActor>() : nullptr;
+		}
+
+		if (const UClass* GameModeClass = LoadObject<UClass>(nullptr, *UGameMapsSettings::GetGlobalDefaultGameMode()))
+		{
+			const ARunnerGameMode* GameModeDefaults = Cast<ARunnerGameMode>(GameModeClass->GetDefaultObject());
+			if (GameModeDefaults && GameModeDefaults->RunnerFloorManager && GameModeDefaults->RunnerFloorManager->TileClass)
+			{
+				return Cast<ARunnerFloorActor>(GameModeDefaults->RunnerFloorManager->TileClass->GetDefaultObject());
+			}
+		}
+		return GetDefault<ARunnerFloorActor>();
+	}
+
+	FLayoutAllocations CountLayoutAllocations(TConstArrayView<const FSpawnSettings*> Spawners, const FVector& FloorExtent, int32 Tiles, int32 WarmupTiles)
+	{
+		const FRandomStream RandomStream(1);
+		FLayoutAllocations Result;
+
+		// Every spawner is laid out on every tile, ignoring the spawn intervals
+		auto LayOutTile = [&]()
+		{
+			for (const FSpawnSettings* Settings : Spawners)
+			{
+				if (!Settings || !Settings->bEnabled || Settings->ActorClasses.Num() == 0)
+				{
+					continue;
+				}
+				RunnerSpawnPolicies::LayOutObjects(*Settings, FloorExtent, RandomStream, [&Result](UClass* ActorClass, const FTransform& SpawnTransform)
+				{
+					++Result.Objects;
+				});
+			}
+		};
+
+		// The first tiles fill the memory stack pages
+		for (int32 Tile = 0; Tile < WarmupTiles; ++Tile)
+		{
+			LayOutTile();
+		}
+
+		FCountingMalloc& CountingMalloc = GetCountingMalloc();
+		FMalloc* const EngineMalloc = GMalloc;
+		GMalloc = &CountingMalloc;
+		Result.Objects = 0;
+		for (int32 Tile = 0; Tile < Tiles; ++Tile)
+		{
+			CountingMalloc.ResetCount();
+			LayOutTile();
+			if (CountingMalloc.GetCount() > 0)
+			{
+				++Result.FailedTiles;
+				Result.Allocations += CountingMalloc.GetCount();
+			}
+		}
+		GMalloc = EngineMalloc;
+
+		return Result;
+	}
+}
+
+URunnerSpawnAllocCommandlet::URunnerSpawnAllocCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 URunnerSpawnAllocCommandlet::Main(const FString& Params)
+{
+	using namespace RunnerSpawnAlloc;
+
+	const ARunnerFloorActor* FloorDefaults = LoadFloorDefaults(Params);
+	if (!FloorDefaults)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RunnerSpawnAlloc: -TileClass is not a floor tile class"));
+		return 1;
+	}
+
+	int32 Tiles = 100;
+	int32 WarmupTiles = 10;
+	FParse::Value(*Params, TEXT("Tiles="), Tiles);
+	FParse::Value(*Params, TEXT("WarmupTiles="), WarmupTiles);
+
+	// Same order as ARunnerFloorActor::SpawnAllObjects
+	TArray<const FSpawnSettings*, TInlineAllocator<4>> Spawners;
+	for (const URunnerSpawnObjectsComponent* Spawner : { FloorDefaults->MovingObstacleSpawner.Get(), FloorDefaults->ObstacleSpawner.Get(), FloorDefaults->PowerupSpawner.Get(), FloorDefaults->CoinSpawner.Get() })
+	{
+		if (Spawner)
+		{
+			Spawners.Add(&Spawner->GetSpawnSettings());
+		}
+	}
+	const double TileLength = FloorDefaults->AttachpointArrow ? FMath::Max(FloorDefaults->AttachpointArrow->GetRelativeLocation().X, 1.0) : 1000.0;
+	const FVector FloorExtent(TileLength * 0.5, 0, 0);
+
+	const FLayoutAllocations Result = CountLayoutAllocations(Spawners, FloorExtent, Tiles, WarmupTiles);
+	if (Result.FailedTiles > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RunnerSpawnAlloc: layout of %d of %d tiles allocated, %d allocations"), Result.FailedTiles, Tiles, Result.Allocations);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("RunnerSpawnAlloc: %d tiles with %d objects laid out without heap allocations"), Tiles, Result.Objects);
+	return 0;
+}
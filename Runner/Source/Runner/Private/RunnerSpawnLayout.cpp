@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSpawnLayout.h"
+
+#include "Misc/MemStack.h"
+
+bool RunnerSpawnLayout::ShouldSpawnOnTile(int32 TileCount, int32 SpawnIntervalBase, int32 SpawnIntervalRandomOffset, const FRandomStream& RandomStream)
+{
+	const int32 RandomizedInterval = SpawnIntervalBase + RandomStream.RandRange(-SpawnIntervalRandomOffset, SpawnIntervalRandomOffset);
+	if (RandomizedInterval <= 0)
+	{
+		return true;
+	}
+	return (TileCount % RandomizedInterval) == 0;
+}
+
+int32 RunnerSpawnLayout::GetSpawnPointNum(const FSpawnSettings& Settings)
+{
+	return FMath::Max(Settings.PointsPerLane, 0) * Settings.LaneYOffsets.Num();
+}
+
+void RunnerSpawnLayout::GenerateSpawnGrid(const FSpawnSettings& Settings, const FVector& FloorExtent, TArrayView<FTransform> OutTransforms)
+{
+	check(OutTransforms.Num() == GetSpawnPointNum(Settings));
+
+	// Calculate spacing dynamically based on the floor size
+	const float FloorWidth = FloorExtent.X * 2;
+	const float UsableWidth = FloorWidth - (2 * Settings.XOffset);
+	const float SpacingX = UsableWidth / (Settings.PointsPerLane + 1);
+
+	// Iterate over the lanes and points
+	int32 Index = 0;
+	for (int32 Point = 0; Point < Settings.PointsPerLane; ++Point)
+	{
+		for (int32 i = 0; i < Settings.LaneYOffsets.Num(); i++)
+		{
+			// Calculate the spawn location for the current lane and point
+			FVector Location(Settings.XOffset + (SpacingX * (Point + 1) - FloorExtent.X), Settings.LaneYOffsets[i], Settings.ZOffset);
+			OutTransforms[Index++] = FTransform(Settings.ActorRotator, Location);
+		}
+	}
+}
+
+void RunnerSpawnLayout::GenerateSpawnGrid(const FSpawnSettings& Settings, const FVector& FloorExtent, TArray<FTransform>& OutTransforms)
+{
+	OutTransforms.SetNumUninitialized(GetSpawnPointNum(Settings), EAllowShrinking::No);
+	GenerateSpawnGrid(Settings, FloorExtent, TArrayView<FTransform>(OutTransforms));
+}
+
+void RunnerSpawnLayout::ShuffleSpawnPoints(TArrayView<FTransform> SpawnTransforms, const FRandomStream& RandomStream)
+{
+	// Fisher-Yates shuffle driven by the given stream
+	for (int32 i = SpawnTransforms.Num() - 1; i > 0; --i)
+	{
+		const int32 SwapIndex = RandomStream.RandRange(0, i);
+		if (SwapIndex != i)
+		{
+			SpawnTransforms.Swap(i, SwapIndex);
+		}
+	}
+}
+
+void RunnerSpawnLayout::RandomizeTransform(const FSpawnSettings& Settings, FTransform& InOutTransform, const FRandomStream& RandomStream)
+{
+	// Randomize rotation if enabled
+	if (Settings.bRandomRotator)
+	{
+		FRotator NewRotation = InOutTransform.GetRotation().Rotator();
+		NewRotation.Yaw = RandomStream.FRandRange(0.0f, 270.0f);
+		InOutTransform.SetRotation(NewRotation.Quaternion());
+	}
+
+	// Randomize Z-axis position if enabled
+	if (Settings.bRandomZaxis)
+	{
+		FVector NewLocation = InOutTransform.GetLocation();
+		NewLocation.Z = RandomStream.FRandRange(-50.0f, 50.0f);
+		InOutTransform.SetLocation(NewLocation);
+	}
+}
+
+UClass* RunnerSpawnLayout::PickActorClass(const FSpawnSettings& Settings, const FRandomStream& RandomStream)
+{
+	if (Settings.ActorClasses.Num() == 0)
+	{
+		return nullptr;
+	}
+	return Settings.ActorClasses[RandomStream.RandRange(0, Settings.ActorClasses.Num() - 1)];
+}
+
+namespace RunnerSpawnLayout
+{
+	/** Shuffles the spawn points and spawns the picked objects */
+	void LayOutGrid(const FSpawnSettings& Settings, TArrayView<FTransform> SpawnTransforms, const FRandomStream& RandomStream,
+		TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn);
+}
+
+void RunnerSpawnLayout::LayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+	TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn)
+{
+	// Released when the layout is done, nested layouts from spawned objects stack on top
+	FMemMark Mark(FMemStack::Get());
+	TArray<FTransform, TMemStackAllocator<>> SpawnTransforms;
+	SpawnTransforms.SetNumUninitialized(GetSpawnPointNum(Settings));
+
+	// Generate spawn points
+	GenerateSpawnGrid(Settings, FloorExtent, SpawnTransforms);
+
+	LayOutGrid(Settings, SpawnTransforms, RandomStream, Spawn);
+}
+
+void RunnerSpawnLayout::LayOutObjects(const FSpawnSettings& Settings, TConstArrayView<FTransform> SpawnGrid, const FRandomStream& RandomStream,
+	TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn)
+{
+	// The shuffle works on a copy, the grid stays untouched
+	FMemMark Mark(FMemStack::Get());
+	TArray<FTransform, TMemStackAllocator<>> SpawnTransforms(SpawnGrid.GetData(), SpawnGrid.Num());
+
+	LayOutGrid(Settings, SpawnTransforms, RandomStream, Spawn);
+}
+
+void RunnerSpawnLayout::LayOutGrid(const FSpawnSettings& Settings, TArrayView<FTransform> SpawnTransforms, const FRandomStream& RandomStream,
+	TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn)
+{
+	// Randomize the order of spawn points
+	ShuffleSpawnPoints(SpawnTransforms, RandomStream);
+
+	// Pick the classes and transforms of the objects
+	const int32 SpawnNum = FMath::Min(Settings.ActorNum, SpawnTransforms.Num());
+	for (int32 i = 0; i < SpawnNum; ++i)
+	{
+		// Pick a random class form the array
+		UClass* ActorClass = PickActorClass(Settings, RandomStream);
+
+		// Randomize rotation and Z-axis position if enabled
+		FTransform NewTransform = SpawnTransforms[i];
+		RandomizeTransform(Settings, NewTransform, RandomStream);
+
+		Spawn(ActorClass, NewTransform);
+	}
+}
@@ -2,73 +2,163 @@
 
 
 #include "RunnerSpawnObjectsComponent.h"
-#include "Algo/RandomShuffle.h"
+#include "RunnerSpawnLayout.h"
+#include "RunnerSpawnPolicies.h"
+#include "RunnerSpawnProfile.h"
+#include "RunnerProfiling.h"
+#include "RunnerSignificanceSubsystem.h"
+#include "RunnerTickSubsystem.h"
+#include "RunnerTileCacheSubsystem.h"
 #include "Components/ArrowComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "CollisionQueryParams.h"
 #include "PropertyAccess.h"
 
+DECLARE_CYCLE_STAT(TEXT("SpawnObjects"), STAT_RunnerSpawnObjects, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("LayOutObjects"), STAT_RunnerLayOutObjects, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("PlanObjects"), STAT_RunnerPlanObjects, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("MaterializeObjects"), STAT_RunnerMaterializeObjects, STATGROUP_Runner);
+
+namespace
+{
+    /** Track the objects alive per spawner type */
+    void AddSpawnedObjectStat(ERunnerSpawnerType SpawnerType, int32 Delta)
+    {
+        switch (SpawnerType)
+        {
+        case ERunnerSpawnerType::Coin:           INC_DWORD_STAT_BY(STAT_RunnerSpawnedCoins, Delta); break;
+        case ERunnerSpawnerType::Powerup:        INC_DWORD_STAT_BY(STAT_RunnerSpawnedPowerups, Delta); break;
+        case ERunnerSpawnerType::Obstacle:       INC_DWORD_STAT_BY(STAT_RunnerSpawnedObstacles, Delta); break;
+        case ERunnerSpawnerType::MovingObstacle: INC_DWORD_STAT_BY(STAT_RunnerSpawnedMovingObstacles, Delta); break;
+        case ERunnerSpawnerType::Scenery:        INC_DWORD_STAT_BY(STAT_RunnerSpawnedScenery, Delta); break;
+        default:                                 INC_DWORD_STAT_BY(STAT_RunnerSpawnedOther, Delta); break;
+        }
+    }
+}
+
 URunnerSpawnObjectsComponent::URunnerSpawnObjectsComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 }
 
+void URunnerSpawnObjectsComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+    // Spawned objects go away with the tile
+    AddSpawnedObjectStat(SpawnerType, -SpawnedObjects.Num());
+    SpawnedObjects.Empty();
+    PlannedObjects.Empty();
+
+    Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+const FSpawnSettings& URunnerSpawnObjectsComponent::GetSpawnSettings() const
+{
+    return SpawnProfile ? SpawnProfile->SpawnSettings : SpawnSettings;
+}
+
 void URunnerSpawnObjectsComponent::SpawnObjects(UChildActorComponent* AttachParent)
+{
+    SpawnObjects(AttachParent, FRandomStream(FMath::Rand()));
+}
+
+void URunnerSpawnObjectsComponent::SpawnObjects(UChildActorComponent* AttachParent, const FRandomStream& RandomStream)
 {
     //UE_LOG(LogTemp, Display, TEXT("URunnerSpawnObjectsComponent::SpawnObjects"));
-    
-    if (!SpawnSettings.bEnabled)
+    RUNNER_SCOPE_COST(SpawnObjects);
+    RUNNER_SCOPE_CYCLE(STAT_RunnerSpawnObjects);
+    RUNNER_LLM_SCOPE_BYNAME(RunnerLLM::GetSpawnerTag(SpawnerType));
+
+    LayOutObjects(AttachParent, RandomStream, [this, AttachParent](UClass* ActorClass, const FTransform& SpawnTransform)
+    {
+        SpawnObjectClass(ActorClass, SpawnTransform, AttachParent);
+    });
+
+    // Remove spawned that overlapped with existing objects
+    //ResolveOverlaps();
+}
+
+void URunnerSpawnObjectsComponent::PlanObjects(UChildActorComponent* AttachParent, const FRandomStream& RandomStream)
+{
+    RUNNER_SCOPE_CYCLE(STAT_RunnerPlanObjects);
+    RUNNER_LLM_SCOPE_BYNAME(RunnerLLM::GetSpawnerTag(SpawnerType));
+
+    // The layout draws from the stream now, so the tile looks the same as if it had been spawned right away
+    const bool bLaidOut = LayOutObjects(AttachParent, RandomStream, [this, AttachParent](UClass* ActorClass, const FTransform& SpawnTransform)
+    {
+        PlannedObjects.Add({ ActorClass, SpawnTransform });
+        AddProxyInstance(ActorClass, SpawnTransform, AttachParent);
+    });
+
+    // Nothing to materialize, the tile manager only tracks spawners with planned objects
+    if (!bLaidOut || !HasPlannedObjects())
     {
         return;
     }
+    PlannedAttachParent = AttachParent;
+}
+
+void URunnerSpawnObjectsComponent::MaterializeObjects()
+{
+    RUNNER_SCOPE_COST(SpawnObjects);
+    RUNNER_SCOPE_CYCLE(STAT_RunnerMaterializeObjects);
+    RUNNER_LLM_SCOPE_BYNAME(RunnerLLM::GetSpawnerTag(SpawnerType));
 
-    if (SpawnSettings.ActorClasses.Num() == 0)
+    if (IsValid(PlannedAttachParent))
+    {
+        for (const FPlannedObject& Object : PlannedObjects)
+        {
+            SpawnObjectClass(Object.ActorClass, Object.SpawnTransform, PlannedAttachParent);
+        }
+    }
+    RemovePlannedObjects();
+}
+
+bool URunnerSpawnObjectsComponent::LayOutObjects(UChildActorComponent* AttachParent, const FRandomStream& RandomStream,
+    TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Place)
+{
+    // Includes the placement callback, which spawns or plans each object
+    RUNNER_SCOPE_COST(LayOutObjects);
+    RUNNER_SCOPE_CYCLE(STAT_RunnerLayOutObjects);
+
+    const FSpawnSettings& Settings = GetSpawnSettings();
+    if (!Settings.bEnabled)
+    {
+        return false;
+    }
+
+    if (Settings.ActorClasses.Num() == 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("No actor class specified"));
-        return;
+        return false;
     }
     
     // Remove existing objects first
     RemoveObjects();
 
-    // Generate spawn points
-    TArray<FTransform> SpawnTransforms = GenerateSpawnTransform(AttachParent);
-
-    // Visualize the spawn points
-    VisualizeSpawnLocations(SpawnTransforms, AttachParent);
+    // Get the scaled floor extent, shared by all tiles of the class when the cache is available
+    URunnerTileCacheSubsystem* TileCache = GetWorld() ? GetWorld()->GetSubsystem<URunnerTileCacheSubsystem>() : nullptr;
+    const FVector FloorExtent = TileCache ? TileCache->GetFloorExtent(AttachParent) : URunnerTileCacheSubsystem::ComputeFloorExtent(AttachParent);
 
-    // Randomize the order of spawn points
-    Algo::RandomShuffle(SpawnTransforms);
-
-    // Spawn the actual objects
-    for (int32 i = 0; i < SpawnSettings.ActorNum; ++i)
+    // Visualize the spawn points in the editor, the arrows are hidden in game
+    if (!GetWorld() || !GetWorld()->IsGameWorld())
     {
-        // Pick a random class form the array
-        TSubclassOf<AActor> ActorClass = SpawnSettings.ActorClasses[FMath::RandRange(0, SpawnSettings.ActorClasses.Num() - 1)];
-
-        FTransform NewTransform = SpawnTransforms[i];
+        VisualizeSpawnLocations(FloorExtent, AttachParent);
+    }
 
-        // Randomize rotation if enabled
-        if (SpawnSettings.bRandomRotator)
+    // Common grid shapes are laid out by a specialized policy, every shipped spawner has one.
+    // Custom shapes fall back to the generic layout on the cached grid.
+    if (!RunnerSpawnPolicies::TryLayOutObjects(Settings, FloorExtent, RandomStream, Place))
+    {
+        if (TileCache)
         {
-            float RandomYaw = FMath::RandRange(0.0f, 270.0f);
-            FRotator NewRotation = NewTransform.GetRotation().Rotator();
-            NewRotation.Yaw = RandomYaw;
-            NewTransform.SetRotation(NewRotation.Quaternion());
+            RunnerSpawnLayout::LayOutObjects(Settings, TileCache->GetSpawnGrid(Settings, FloorExtent), RandomStream, Place);
         }
-
-        // Randomize Z-axis position if enabled
-        if (SpawnSettings.bRandomZaxis)
+        else
         {
-            FVector NewLocation = NewTransform.GetLocation();
-            NewLocation.Z = FMath::RandRange(-50.0f, 50.0f); // Random Y-axis position between 0 and 1000 cm
-            NewTransform.SetLocation(NewLocation);
+            RunnerSpawnLayout::LayOutObjects(Settings, FloorExtent, RandomStream, Place);
         }
-
-        SpawnObjectClass(ActorClass, NewTransform, AttachParent);
     }
-
-    // Remove spawned that overlapped with existing objects
-    //ResolveOverlaps();
+    return true;
 }
 
 void URunnerSpawnObjectsComponent::RemoveObjects()
@@ -81,7 +171,34 @@ void URunnerSpawnObjectsComponent::RemoveObjects()
             Object->DestroyComponent();
         }
     }
-    SpawnedObjects.Empty();
+    AddSpawnedObjectStat(SpawnerType, -SpawnedObjects.Num());
+    SpawnedObjects.Reset();
+
+    RemovePlannedObjects();
+}
+
+int32 URunnerSpawnObjectsComponent::ReclaimObjectsBehind(double TrackX)
+{
+    int32 Reclaimed = 0;
+    for (int32 i = SpawnedObjects.Num() - 1; i >= 0; --i)
+    {
+        // Collected objects leave their component behind
+        UChildActorComponent* Object = SpawnedObjects[i];
+        const AActor* ChildActor = Object ? Object->GetChildActor() : nullptr;
+        if (IsValid(ChildActor) && ChildActor->GetActorLocation().X >= TrackX)
+        {
+            continue;
+        }
+
+        if (Object)
+        {
+            Object->DestroyComponent();
+        }
+        SpawnedObjects.RemoveAtSwap(i, 1, EAllowShrinking::No);
+        ++Reclaimed;
+    }
+    AddSpawnedObjectStat(SpawnerType, -Reclaimed);
+    return Reclaimed;
 }
 
 void URunnerSpawnObjectsComponent::SpawnObjectClass(UClass* ActorClass, const FTransform& SpawnTransform, UChildActorComponent* AttachParent)
@@ -94,63 +211,64 @@ void URunnerSpawnObjectsComponent::SpawnObjectClass(UClass* ActorClass, const FT
         NewChildActor->SetRelativeTransform(SpawnTransform);
         NewChildActor->RegisterComponent();
         SpawnedObjects.Add(NewChildActor);
+        AddSpawnedObjectStat(SpawnerType, 1);
+
+        if (URunnerTickSubsystem* TickSubsystem = GetWorld()->GetSubsystem<URunnerTickSubsystem>())
+        {
+            TickSubsystem->ApplyToSpawned(NewChildActor->GetChildActor(), SpawnerType);
+        }
+
+        // Registered after the tick policies, so the tiers reduce from the enforced ticks
+        if (URunnerSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<URunnerSignificanceSubsystem>())
+        {
+            SignificanceSubsystem->Register(NewChildActor->GetChildActor(), SpawnerType);
+        }
 
         //UE_LOG(LogTemp, Display, TEXT("Spawned object : %s at location %s"), *NewChildActor->GetName(), *NewChildActor->GetRelativeLocation().ToString());
     }
 }
 
-TArray<FTransform> URunnerSpawnObjectsComponent::GenerateSpawnTransform(const UChildActorComponent* AttachParent) const
+void URunnerSpawnObjectsComponent::AddProxyInstance(UClass* ActorClass, const FTransform& SpawnTransform, UChildActorComponent* AttachParent)
 {
-    // Get the scaled floor extent
-    const FVector FloorExtent = CalculateFloorExtent(AttachParent);
-    //UE_LOG(LogTemp, Display, TEXT("FloorExtent is %s"), *FloorExtent.ToString());
-
-    // Calculate spacing dynamically based on AttachParent's size
-    const float FloorWidth = FloorExtent.X * 2; 
-    const float UsableWidth = FloorWidth - (2 * SpawnSettings.XOffset);
-    const float SpacingX = UsableWidth / (SpawnSettings.PointsPerLane + 1);
-
-    // Iterate over the lanes and points
-    TArray<FTransform> SpawnTransforms;
-    for (int32 Point = 0; Point < SpawnSettings.PointsPerLane; ++Point)
+    URunnerTileCacheSubsystem* TileCache = GetWorld()->GetSubsystem<URunnerTileCacheSubsystem>();
+    const URunnerTileCacheSubsystem::FProxyMesh* ProxyMesh = TileCache ? TileCache->GetProxyMesh(ActorClass) : nullptr;
+    if (!ProxyMesh)
     {
-        for (int32 i = 0; i < SpawnSettings.LaneYOffsets.Num(); i++)
-        {
-            // Calculate the spawn location for the current lane and point
-            FVector Location(SpawnSettings.XOffset + (SpacingX * (Point + 1)- FloorExtent.X), SpawnSettings.LaneYOffsets[i], SpawnSettings.ZOffset);
-            FRotator Rotation = SpawnSettings.ActorRotator;
-
-            SpawnTransforms.Add(FTransform(Rotation, Location));
-            //UE_LOG(LogTemp, Display, TEXT("Spawn Transform %s"), *Location.ToString());
-        }
+        return;
     }
 
-    return SpawnTransforms;
+    // One instanced mesh per mesh, only drawn
+    TObjectPtr<UInstancedStaticMeshComponent>* Found = ProxyComponents.FindByPredicate([ProxyMesh](const UInstancedStaticMeshComponent* Proxy)
+    {
+        return Proxy->GetStaticMesh() == ProxyMesh->Mesh;
+    });
+    UInstancedStaticMeshComponent* Proxy = Found ? Found->Get() : nullptr;
+    if (!Proxy)
+    {
+        Proxy = NewObject<UInstancedStaticMeshComponent>(this);
+        Proxy->SetStaticMesh(ProxyMesh->Mesh);
+        Proxy->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Proxy->SetCanEverAffectNavigation(false);
+        Proxy->SetCastShadow(false);
+        Proxy->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepRelativeTransform);
+        Proxy->RegisterComponent();
+        ProxyComponents.Add(Proxy);
+    }
+    Proxy->AddInstance(ProxyMesh->RelativeTransform * SpawnTransform);
 }
 
-FVector URunnerSpawnObjectsComponent::CalculateFloorExtent(const UChildActorComponent* AttachParent) const
+void URunnerSpawnObjectsComponent::RemovePlannedObjects()
 {
-    FVector FloorExtent = FVector::ZeroVector;
-
-    if (IsValid(AttachParent) && IsValid(AttachParent->GetChildActor()))
+    for (UInstancedStaticMeshComponent* Proxy : ProxyComponents)
     {
-        // Get the child actor
-        AActor* ChildActor = AttachParent->GetChildActor();
-        if (IsValid(ChildActor))
+        if (Proxy)
         {
-            // Now access the StaticMeshComponent of the child actor
-            UStaticMeshComponent* StaticMeshComp = ChildActor->FindComponentByClass<UStaticMeshComponent>();
-            if (IsValid(StaticMeshComp))
-            {
-                const FVector MeshExtent = StaticMeshComp->GetStaticMesh()->GetBoundingBox().GetExtent();
-                const FVector ComponentScale = StaticMeshComp->GetComponentScale(); 
-                FloorExtent = MeshExtent * ComponentScale;
-            }
+            Proxy->DestroyComponent();
         }
     }
-
-    //UE_LOG(LogTemp, Display, TEXT("FloorExtend: %s"), *FloorExtent.ToString());
-    return FloorExtent;
+    ProxyComponents.Reset();
+    PlannedObjects.Reset();
+    PlannedAttachParent = nullptr;
 }
 
 void URunnerSpawnObjectsComponent::ResolveOverlaps()
@@ -194,6 +312,7 @@ void URunnerSpawnObjectsComponent::ResolveOverlaps()
             {
                 UE_LOG(LogTemp, Display, TEXT("SpawnedActor %s overlapped with others, delete it"), *SpawnedActor->GetName());
                 SpawnedObjects.RemoveAt(i);
+                AddSpawnedObjectStat(SpawnerType, -1);
                 Object->DestroyComponent();
             }           
         }
@@ -215,9 +334,12 @@ void URunnerSpawnObjectsComponent::AddArrowComponent(const FVector& Location, co
     SpawnedArrows.Add(ArrowComponent);
 }
 
-void URunnerSpawnObjectsComponent::VisualizeSpawnLocations(const TArray<FTransform>& SpawnTransforms, UChildActorComponent* AttachParent)
+void URunnerSpawnObjectsComponent::VisualizeSpawnLocations(const FVector& FloorExtent, UChildActorComponent* AttachParent)
 {
     RemoveArrowComponents();
+
+    TArray<FTransform> SpawnTransforms;
+    RunnerSpawnLayout::GenerateSpawnGrid(GetSpawnSettings(), FloorExtent, SpawnTransforms);
     
     // Visualize the spawn locations using arrows
     for (const FTransform& Transform : SpawnTransforms)
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSpawnPolicies.h"
+
+namespace RunnerSpawnPolicies
+{
+	/** Lays out with the first policy matching the settings */
+	template <typename... PolicyTypes>
+	bool TryLayOutWithPolicies(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+		TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn)
+	{
+		return ((PolicyTypes::Matches(Settings) ? (PolicyTypes::LayOutObjects(Settings, FloorExtent, RandomStream, Spawn), true) : false) || ...);
+	}
+}
+
+bool RunnerSpawnPolicies::TryLayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+	TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn)
+{
+	return TryLayOutWithPolicies<FLaneRowPolicy, FLaneSlotPolicy, FScatterPolicy, FScatterRotatedPolicy, FScatterRotatedRaisedPolicy>(
+		Settings, FloorExtent, RandomStream, Spawn);
+}
+
+void RunnerSpawnPolicies::LayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+	TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn)
+{
+	if (!TryLayOutObjects(Settings, FloorExtent, RandomStream, Spawn))
+	{
+		RunnerSpawnLayout::LayOutObjects(Settings, FloorExtent, RandomStream, Spawn);
+	}
+}
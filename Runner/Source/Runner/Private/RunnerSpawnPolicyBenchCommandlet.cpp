@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSpawnPolicyBenchCommandlet.h"
+
+#include "RunnerSpawnLayout.h"
+#include "RunnerSpawnPolicies.h"
+#include "GameFramework/Pawn.h"
+
+namespace RunnerSpawnPolicyBench
+{
+	FSpawnSettings MakeSettings(int32 ActorNum, int32 PointsPerLane, const TArray<float>& LaneYOffsets, bool bRandomRotator, bool bRandomZaxis)
+	{
+		FSpawnSettings Settings;
+		Settings.ActorClasses = { AActor::StaticClass(), APawn::StaticClass() };
+		Settings.ActorNum = ActorNum;
+		Settings.PointsPerLane = PointsPerLane;
+		Settings.LaneYOffsets = LaneYOffsets;
+		Settings.XOffset = 50;
+		Settings.bRandomRotator = bRandomRotator;
+		Settings.bRandomZaxis = bRandomZaxis;
+		return Settings;
+	}
+
+	TArray<FBenchCase> MakeCases()
+	{
+		using namespace RunnerSpawnPolicies;
+
+		const TArray<float> FloorLanes = { -325, 0, 325 };
+		const TArray<float> SkylineLane = { 0 };
+		return {
+			{ TEXT("LaneRow"), MakeSettings(10, 6, FloorLanes, false, false), &FLaneRowPolicy::Matches },
+			{ TEXT("LaneSlot"), MakeSettings(1, 2, FloorLanes, false, false), &FLaneSlotPolicy::Matches },
+			{ TEXT("Scatter"), MakeSettings(3, 6, SkylineLane, false, false), &FScatterPolicy::Matches },
+			{ TEXT("ScatterRotated"), MakeSettings(3, 6, SkylineLane, true, false), &FScatterRotatedPolicy::Matches },
+			{ TEXT("ScatterRotatedRaised"), MakeSettings(3, 6, SkylineLane, true, true), &FScatterRotatedRaisedPolicy::Matches },
+		};
+	}
+
+	/** Returns the seconds per layout of one path, the checksum keeps the spawned transforms alive */
+	template <typename LayOutFuncType>
+	double Measure(int32 Iterations, int32 Seed, double& Checksum, LayOutFuncType&& LayOut)
+	{
+		const FRandomStream RandomStream(Seed);
+		auto Spawn = [&Checksum](UClass* ActorClass, const FTransform& SpawnTransform)
+		{
+			Checksum += SpawnTransform.GetLocation().X;
+		};
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Layout = 0; Layout < Iterations; ++Layout)
+		{
+			LayOut(RandomStream, Spawn);
+		}
+		return (FPlatformTime::Seconds() - StartTime) / FMath::Max(Iterations, 1);
+	}
+}
+
+URunnerSpawnPolicyBenchCommandlet::URunnerSpawnPolicyBenchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 URunnerSpawnPolicyBenchCommandlet::Main(const FString& Params)
+{
+	using namespace RunnerSpawnPolicyBench;
+
+	int32 Iterations = 200000;
+	int32 Seed = 1;
+	float TileLength = 1000.0f;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("TileLength="), TileLength);
+	const FVector FloorExtent(TileLength * 0.5f, 0, 0);
+
+	double Checksum = 0;
+	for (const FBenchCase& Case : MakeCases())
+	{
+		const double GenericSeconds = Measure(Iterations, Seed, Checksum, [&](const FRandomStream& RandomStream, auto& Spawn)
+		{
+			RunnerSpawnLayout::LayOutObjects(Case.Settings, FloorExtent, RandomStream, Spawn);
+		});
+		const double SpecializedSeconds = Measure(Iterations, Seed, Checksum, [&](const FRandomStream& RandomStream, auto& Spawn)
+		{
+			RunnerSpawnPolicies::TryLayOutObjects(Case.Settings, FloorExtent, RandomStream, Spawn);
+		});
+
+		UE_LOG(LogTemp, Display, TEXT("RunnerSpawnPolicyBench: %-20s generic %8.1f ns, specialized %8.1f ns, speedup %.2fx"),
+			Case.Name, GenericSeconds * 1e9, SpecializedSeconds * 1e9, SpecializedSeconds > 0 ? GenericSeconds / SpecializedSeconds : 0.0);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("RunnerSpawnPolicyBench: %d layouts per path, checksum %.0f"), Iterations, Checksum);
+	return 0;
+}
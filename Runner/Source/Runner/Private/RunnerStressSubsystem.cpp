@@ -0,0 +1,349 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerStressSubsystem.h"
+#include "RunnerCharacter.h"
+#include "RunnerFloorActor.h"
+#include "RunnerGameMode.h"
+#include "RunnerGenericStruct.h"
+#include "RunnerSimulationComponent.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTileManager.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace RunnerStressRamp
+{
+	constexpr float DensityStep = 0.5f;
+	constexpr float MaxDensity = 32;
+
+	/** Seconds to wait after regenerating the tiles before measuring */
+	constexpr float SettleSeconds = 2;
+
+	/** Seconds measured per step */
+	constexpr float SampleSeconds = 5;
+
+	/** Returns the given percentile of the samples, sorts the samples */
+	float Percentile(TArray<float>& Samples, float Percent)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0;
+		}
+		Samples.Sort();
+		return Samples[FMath::Clamp(FMath::CeilToInt32(Percent * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	}
+}
+
+bool URunnerStressSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+bool URunnerStressSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerStressSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FString Budget;
+	if (FParse::Value(FCommandLine::Get(), TEXT("RunnerStressRamp="), Budget) || FParse::Param(FCommandLine::Get(), TEXT("RunnerStressRamp")))
+	{
+		StartRamp(Budget.IsEmpty() ? RampBudgetMs : FCString::Atof(*Budget));
+		bQuitAfterRamp = true;
+	}
+}
+
+TStatId URunnerStressSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerStressSubsystem, STATGROUP_Tickables);
+}
+
+void URunnerStressSubsystem::SetSettings(const FRunnerStressSettings& InSettings)
+{
+	Settings = InSettings;
+	Settings.DensityMultiplier = FMath::Max(Settings.DensityMultiplier, 0.0f);
+	Settings.LaneMultiplier = FMath::Max(Settings.LaneMultiplier, 1);
+
+	// Tiles in the world already spawned their objects, but the speed applies when they are passed
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	if (MyGameMode && MyGameMode->RunnerFloorManager)
+	{
+		for (AActor* Tile : MyGameMode->RunnerFloorManager->GetTileActors())
+		{
+			if (ARunnerFloorActor* Floor = Cast<ARunnerFloorActor>(Tile))
+			{
+				const ARunnerFloorActor* Defaults = Floor->GetClass()->GetDefaultObject<ARunnerFloorActor>();
+				Floor->MaxSpeed = Settings.ForcedMaxSpeed > 0 ? Settings.ForcedMaxSpeed : Defaults->MaxSpeed;
+				Floor->SpeedIncrement = Settings.ForcedMaxSpeed > 0 ? Settings.ForcedMaxSpeed : Defaults->SpeedIncrement;
+			}
+		}
+
+		// The player simulation derives passed tiles itself and only takes the speed settings from the floor class
+		const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+		const ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+		const TSubclassOf<AActor> TileClass = MyGameMode->RunnerFloorManager->TileClass;
+		const ARunnerFloorActor* FloorDefaults = TileClass ? Cast<ARunnerFloorActor>(TileClass->GetDefaultObject()) : nullptr;
+		if (MyCharacter && MyCharacter->GetSimulation() && FloorDefaults)
+		{
+			FRunnerSimConfig TileConfig = MyCharacter->GetSimulation()->Config;
+			TileConfig.SpeedIncrement = FloorDefaults->SpeedIncrement;
+			TileConfig.MaxSpeed = FloorDefaults->MaxSpeed;
+			ApplyToSimulation(TileConfig);
+			MyCharacter->GetSimulation()->SetTileSpeed(TileConfig.SpeedIncrement, TileConfig.MaxSpeed);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: density x%.2f, lanes x%d, forced max speed %.0f"),
+		Settings.DensityMultiplier, Settings.LaneMultiplier, Settings.ForcedMaxSpeed);
+}
+
+void URunnerStressSubsystem::ApplyToSimulation(FRunnerSimConfig& Config) const
+{
+	if (Settings.ForcedMaxSpeed > 0)
+	{
+		Config.MaxSpeed = Settings.ForcedMaxSpeed;
+		Config.SpeedIncrement = Settings.ForcedMaxSpeed;
+	}
+}
+
+void URunnerStressSubsystem::ApplyToFloor(ARunnerFloorActor& Floor) const
+{
+	if (Settings.IsDefault())
+	{
+		return;
+	}
+
+	if (Settings.ForcedMaxSpeed > 0)
+	{
+		// The passed tile raises the speed up to its MaxSpeed, an increment of the full speed reaches it on the next tile
+		Floor.MaxSpeed = Settings.ForcedMaxSpeed;
+		Floor.SpeedIncrement = Settings.ForcedMaxSpeed;
+	}
+
+	for (URunnerSpawnObjectsComponent* Spawner : {Floor.CoinSpawner.Get(), Floor.PowerupSpawner.Get(), Floor.ObstacleSpawner.Get(), Floor.MovingObstacleSpawner.Get()})
+	{
+		if (!Spawner)
+		{
+			continue;
+		}
+
+		// Start from the template so applying twice does not compound, a shared profile is copied and left untouched
+		const URunnerSpawnObjectsComponent* Template = Cast<URunnerSpawnObjectsComponent>(Spawner->GetArchetype());
+		Spawner->SpawnSettings = Template ? Template->GetSpawnSettings() : Spawner->GetSpawnSettings();
+		Spawner->SpawnProfile = nullptr;
+		ApplyToSpawnSettings(Spawner->SpawnSettings);
+	}
+}
+
+void URunnerStressSubsystem::ApplyToSpawnSettings(FSpawnSettings& SpawnSettings) const
+{
+	// Spread the multiplied lanes over the span of the original lanes, or over three default lanes for a single lane
+	if (Settings.LaneMultiplier > 1 && SpawnSettings.LaneYOffsets.Num() > 0)
+	{
+		const float Min = FMath::Min(SpawnSettings.LaneYOffsets);
+		const float Max = FMath::Max(SpawnSettings.LaneYOffsets);
+		const float Center = (Min + Max) / 2;
+		const float Span = Max > Min ? Max - Min : 650;
+		const int32 LaneCount = SpawnSettings.LaneYOffsets.Num() * Settings.LaneMultiplier;
+
+		SpawnSettings.LaneYOffsets.Reset(LaneCount);
+		for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+		{
+			SpawnSettings.LaneYOffsets.Add(Center - Span / 2 + Span * Lane / (LaneCount - 1));
+		}
+	}
+
+	// Add spawn points when the grid is too small for the multiplied actor count
+	SpawnSettings.ActorNum = FMath::RoundToInt32(SpawnSettings.ActorNum * Settings.DensityMultiplier);
+	const int32 LaneCount = FMath::Max(SpawnSettings.LaneYOffsets.Num(), 1);
+	SpawnSettings.PointsPerLane = FMath::Max(SpawnSettings.PointsPerLane, FMath::DivideAndRoundUp(SpawnSettings.ActorNum, LaneCount));
+}
+
+void URunnerStressSubsystem::SetTilesAhead(int32 TilesAhead)
+{
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	if (!MyGameMode || !MyGameMode->RunnerFloorManager)
+	{
+		return;
+	}
+
+	URunnerTileManager* FloorManager = MyGameMode->RunnerFloorManager;
+	const int32 Added = FMath::Max(TilesAhead - FloorManager->TilesAheadPlayer, 0);
+	FloorManager->TilesAheadPlayer = FMath::Max(TilesAhead, 1);
+
+	// The window grew, so extending only adds tiles
+	for (int32 i = 0; i < Added; ++i)
+	{
+		FloorManager->ExtendTile();
+	}
+	UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: %d floor tiles ahead"), FloorManager->TilesAheadPlayer);
+}
+
+void URunnerStressSubsystem::FastForward(int32 Tiles)
+{
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (!MyGameMode || !MyGameMode->RunnerFloorManager || !MyCharacter || Tiles <= 0)
+	{
+		return;
+	}
+
+	URunnerTileManager* FloorManager = MyGameMode->RunnerFloorManager;
+	for (int32 i = 0; i < Tiles; ++i)
+	{
+		FloorManager->ExtendTile();
+	}
+
+	// Put the player on the first tile of the ones kept ahead
+	const TArray<AActor*>& FloorTiles = FloorManager->GetTileActors();
+	const int32 TileIndex = FMath::Max(FloorTiles.Num() - FloorManager->TilesAheadPlayer, 0);
+	if (!FloorTiles.IsValidIndex(TileIndex) || !FloorTiles[TileIndex])
+	{
+		return;
+	}
+	const double OldX = MyCharacter->GetActorLocation().X;
+	FVector NewLocation = MyCharacter->GetActorLocation();
+	NewLocation.X = FloorTiles[TileIndex]->GetActorLocation().X + 100;
+	MyCharacter->SetActorLocation(NewLocation, false, nullptr, ETeleportType::TeleportPhysics);
+
+	// Keep the skyline as far ahead of the player as it was
+	URunnerTileManager* SkylineManager = MyGameMode->RunnerSkylineManager;
+	if (SkylineManager && SkylineManager->GetTileActors().Num() > 0 && SkylineManager->GetTileActors().Last())
+	{
+		const double SkylineAhead = SkylineManager->GetTileActors().Last()->GetActorLocation().X - OldX;
+		for (int32 i = 0; i < Tiles * 4 && SkylineManager->GetTileActors().Last()->GetActorLocation().X - NewLocation.X < SkylineAhead; ++i)
+		{
+			SkylineManager->ExtendTile();
+		}
+	}
+	UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: fast-forwarded %d floor tiles"), Tiles);
+}
+
+void URunnerStressSubsystem::StartRamp(float BudgetMs)
+{
+	RampBudgetMs = BudgetMs > 0 ? BudgetMs : RampBudgetMs;
+	RampFrameTimes.Reset();
+	RampFrameTimes.Reserve(FMath::CeilToInt32(RunnerStressRamp::SampleSeconds * 240));
+	RampReport.Reset();
+	RampReport.Add(TEXT("Density,Lanes,FrameP50Ms,FrameP95Ms,Actors"));
+	LastPassingDensity = 0;
+	bRamping = true;
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: ramping density until the p95 frame time crosses %.2f ms"), RampBudgetMs);
+	BeginRampStep(1);
+}
+
+void URunnerStressSubsystem::StopRamp()
+{
+	if (bRamping)
+	{
+		FinishRamp(TEXT("stopped"));
+	}
+}
+
+void URunnerStressSubsystem::BeginRampStep(float Density)
+{
+	FRunnerStressSettings NewSettings = Settings;
+	NewSettings.DensityMultiplier = Density;
+	SetSettings(NewSettings);
+
+	// Regenerate every tile ahead so the whole window has the new density
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	if (MyGameMode && MyGameMode->RunnerFloorManager)
+	{
+		FastForward(MyGameMode->RunnerFloorManager->TilesAheadPlayer);
+	}
+
+	RampFrameTimes.Reset();
+	RampSettleTime = RunnerStressRamp::SettleSeconds;
+	RampSampleTime = RunnerStressRamp::SampleSeconds;
+}
+
+void URunnerStressSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bRamping)
+	{
+		return;
+	}
+
+	// Death pauses the game and the run does not go on, end the ramp so unattended runs always quit
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (MyCharacter && MyCharacter->bIsDead)
+	{
+		FinishRamp(FString::Printf(TEXT("aborted, the player died at density x%.2f, last within budget x%.2f"), Settings.DensityMultiplier, LastPassingDensity));
+		return;
+	}
+
+	// Frames of the pause menu are not measured
+	if (GetWorld()->IsPaused())
+	{
+		return;
+	}
+
+	if (RampSettleTime > 0)
+	{
+		RampSettleTime -= DeltaTime;
+		return;
+	}
+
+	RampFrameTimes.Add(DeltaTime * 1000.0f);
+	RampSampleTime -= DeltaTime;
+	if (RampSampleTime > 0)
+	{
+		return;
+	}
+
+	const float P50 = RunnerStressRamp::Percentile(RampFrameTimes, 0.50f);
+	const float P95 = RunnerStressRamp::Percentile(RampFrameTimes, 0.95f);
+	const int32 Actors = GetWorld()->GetActorCount();
+	RampReport.Add(FString::Printf(TEXT("%.2f,%d,%.3f,%.3f,%d"), Settings.DensityMultiplier, Settings.LaneMultiplier, P50, P95, Actors));
+	UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: density x%.2f p50 %.2f ms p95 %.2f ms, %d actors"), Settings.DensityMultiplier, P50, P95, Actors);
+
+	if (P95 > RampBudgetMs)
+	{
+		FinishRamp(FString::Printf(TEXT("breaking point at density x%.2f (p95 %.2f ms, %d actors), last within budget x%.2f"),
+			Settings.DensityMultiplier, P95, Actors, LastPassingDensity));
+		return;
+	}
+
+	LastPassingDensity = Settings.DensityMultiplier;
+	if (Settings.DensityMultiplier + RunnerStressRamp::DensityStep > RunnerStressRamp::MaxDensity)
+	{
+		FinishRamp(FString::Printf(TEXT("no breaking point up to density x%.2f"), LastPassingDensity));
+		return;
+	}
+	BeginRampStep(Settings.DensityMultiplier + RunnerStressRamp::DensityStep);
+}
+
+void URunnerStressSubsystem::FinishRamp(const FString& Result)
+{
+	bRamping = false;
+	UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: ramp with a %.2f ms budget finished, %s"), RampBudgetMs, *Result);
+
+	const FString ReportPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("RunnerStressRamp.csv");
+	RampReport.Add(FString::Printf(TEXT("# %s"), *Result));
+	if (FFileHelper::SaveStringArrayToFile(RampReport, *ReportPath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("URunnerStressSubsystem: ramp report written to %s"), *ReportPath);
+	}
+
+	if (bQuitAfterRamp)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerTelemetry.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace RunnerTelemetryFile
+{
+	/** "RTEL" */
+	constexpr uint32 Magic = 0x4C455452;
+	constexpr uint32 Version = 1;
+
+	/** Size of one frame over all columns */
+	constexpr int64 FrameSize = 4 * sizeof(float) + 2 * sizeof(int32) + sizeof(uint16) + sizeof(uint8);
+
+	template <typename T>
+	void ReadColumn(FArchive& Ar, TArray<T>& Column, int32 Count)
+	{
+		Column.SetNumUninitialized(Count);
+		Ar.Serialize(Column.GetData(), Count * sizeof(T));
+	}
+}
+
+void FRunnerTelemetryRecorder::Init(int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 1);
+	Head = 0;
+	Count = 0;
+	TotalRecorded = 0;
+
+	Times.SetNumZeroed(Capacity);
+	FrameTimesMs.SetNumZeroed(Capacity);
+	Speeds.SetNumZeroed(Capacity);
+	TileCounts.SetNumZeroed(Capacity);
+	LiveActors.SetNumZeroed(Capacity);
+	SpawnCalls.SetNumZeroed(Capacity);
+	SpawnMs.SetNumZeroed(Capacity);
+	MagnetActive.SetNumZeroed(Capacity);
+}
+
+void FRunnerTelemetryRecorder::Record(const FRunnerTelemetrySample& Sample)
+{
+	if (Capacity == 0)
+	{
+		return;
+	}
+
+	Times[Head] = Sample.Time;
+	FrameTimesMs[Head] = Sample.FrameTimeMs;
+	Speeds[Head] = Sample.Speed;
+	TileCounts[Head] = Sample.TileCount;
+	LiveActors[Head] = Sample.LiveActors;
+	SpawnCalls[Head] = Sample.SpawnCalls;
+	SpawnMs[Head] = Sample.SpawnMs;
+	MagnetActive[Head] = Sample.bMagnetActive ? 1 : 0;
+
+	Head = (Head + 1) % Capacity;
+	Count = FMath::Min(Count + 1, Capacity);
+	++TotalRecorded;
+}
+
+FRunnerTelemetrySample FRunnerTelemetryRecorder::GetSample(int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+	const int32 BufferIndex = (GetFirstIndex() + Index) % Capacity;
+
+	FRunnerTelemetrySample Sample;
+	Sample.Time = Times[BufferIndex];
+	Sample.FrameTimeMs = FrameTimesMs[BufferIndex];
+	Sample.Speed = Speeds[BufferIndex];
+	Sample.TileCount = TileCounts[BufferIndex];
+	Sample.LiveActors = LiveActors[BufferIndex];
+	Sample.SpawnCalls = SpawnCalls[BufferIndex];
+	Sample.SpawnMs = SpawnMs[BufferIndex];
+	Sample.bMagnetActive = MagnetActive[BufferIndex] != 0;
+	return Sample;
+}
+
+template <typename T>
+void FRunnerTelemetryRecorder::WriteColumn(FArchive& Ar, const TArray<T>& Column) const
+{
+	// The oldest frames run from the first index to the end of the buffer, the rest wrap around to the start
+	const int32 First = GetFirstIndex();
+	const int32 FirstPart = FMath::Min(Count, Capacity - First);
+	Ar.Serialize(const_cast<T*>(Column.GetData() + First), FirstPart * sizeof(T));
+	Ar.Serialize(const_cast<T*>(Column.GetData()), (Count - FirstPart) * sizeof(T));
+}
+
+bool FRunnerTelemetryRecorder::SaveToFile(const FString& Path) const
+{
+	const TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerTelemetryRecorder: failed to open %s"), *Path);
+		return false;
+	}
+
+	uint32 Magic = RunnerTelemetryFile::Magic;
+	uint32 Version = RunnerTelemetryFile::Version;
+	FString SessionCopy = Session;
+	int32 CountCopy = Count;
+	int64 TotalCopy = TotalRecorded;
+	*Ar << Magic << Version << SessionCopy << CountCopy << TotalCopy;
+
+	WriteColumn(*Ar, Times);
+	WriteColumn(*Ar, FrameTimesMs);
+	WriteColumn(*Ar, Speeds);
+	WriteColumn(*Ar, TileCounts);
+	WriteColumn(*Ar, LiveActors);
+	WriteColumn(*Ar, SpawnCalls);
+	WriteColumn(*Ar, SpawnMs);
+	WriteColumn(*Ar, MagnetActive);
+
+	return Ar->Close();
+}
+
+bool FRunnerTelemetryRecorder::LoadFromFile(const FString& Path)
+{
+	const TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Path));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerTelemetryRecorder: failed to open %s"), *Path);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	*Ar << Magic << Version;
+	if (Magic != RunnerTelemetryFile::Magic || Version != RunnerTelemetryFile::Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerTelemetryRecorder: %s is not a version %u telemetry file"), *Path, RunnerTelemetryFile::Version);
+		return false;
+	}
+
+	int32 FileCount = 0;
+	*Ar << Session << FileCount << TotalRecorded;
+	if (FileCount < 0 || Ar->TotalSize() < Ar->Tell() + FileCount * RunnerTelemetryFile::FrameSize)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerTelemetryRecorder: %s is truncated"), *Path);
+		return false;
+	}
+
+	RunnerTelemetryFile::ReadColumn(*Ar, Times, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, FrameTimesMs, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, Speeds, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, TileCounts, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, LiveActors, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, SpawnCalls, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, SpawnMs, FileCount);
+	RunnerTelemetryFile::ReadColumn(*Ar, MagnetActive, FileCount);
+
+	// The file is stored oldest first, so the loaded buffer is full and starts at index 0
+	Capacity = FileCount;
+	Count = FileCount;
+	Head = 0;
+	return !Ar->IsError();
+}
+
+bool FRunnerTelemetryRecorder::ExportCsv(const FString& Path) const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Count + 1);
+	Lines.Add(TEXT("Time,FrameTimeMs,Speed,TileCount,LiveActors,SpawnCalls,SpawnMs,MagnetActive"));
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FRunnerTelemetrySample Sample = GetSample(Index);
+		Lines.Add(FString::Printf(TEXT("%.4f,%.3f,%.1f,%d,%d,%d,%.4f,%d"),
+			Sample.Time, Sample.FrameTimeMs, Sample.Speed, Sample.TileCount, Sample.LiveActors,
+			Sample.SpawnCalls, Sample.SpawnMs, Sample.bMagnetActive ? 1 : 0));
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRunnerTelemetryRecorder: failed to write %s"), *Path);
+		return false;
+	}
+	return true;
+}
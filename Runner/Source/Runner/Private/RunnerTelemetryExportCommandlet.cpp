@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerTelemetryExportCommandlet.h"
+#include "RunnerTelemetry.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+URunnerTelemetryExportCommandlet::URunnerTelemetryExportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 URunnerTelemetryExportCommandlet::Main(const FString& Params)
+{
+	FString Input;
+	if (!FParse::Value(*Params, TEXT("Input="), Input))
+	{
+		UE_LOG(LogTemp, Error, TEXT("RunnerTelemetryExport: -Input=<.rtel file or directory> is required"));
+		return 1;
+	}
+	FString Output;
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	TArray<FString> Files;
+	const bool bDirectory = IFileManager::Get().DirectoryExists(*Input);
+	if (bDirectory)
+	{
+		IFileManager::Get().FindFiles(Files, *(Input / TEXT("*.rtel")), true, false);
+		for (FString& File : Files)
+		{
+			File = Input / File;
+		}
+	}
+	else
+	{
+		Files.Add(Input);
+	}
+
+	int32 Failures = 0;
+	for (const FString& File : Files)
+	{
+		FString CsvPath = FPaths::ChangeExtension(File, TEXT("csv"));
+		if (!Output.IsEmpty())
+		{
+			CsvPath = bDirectory ? Output / FPaths::GetCleanFilename(CsvPath) : Output;
+		}
+
+		FRunnerTelemetryRecorder Recorder;
+		if (!Recorder.LoadFromFile(File) || !Recorder.ExportCsv(CsvPath))
+		{
+			++Failures;
+			continue;
+		}
+		UE_LOG(LogTemp, Display, TEXT("RunnerTelemetryExport: %s -> %s (%d frames of %lld recorded, %s)"),
+			*File, *CsvPath, Recorder.Num(), Recorder.GetTotalRecorded(), *Recorder.Session);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("RunnerTelemetryExport: exported %d of %d files"), Files.Num() - Failures, Files.Num());
+	return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerTelemetrySubsystem.h"
+#include "RunnerCharacter.h"
+#include "RunnerGameMode.h"
+#include "RunnerProfiling.h"
+#include "RunnerTileManager.h"
+
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+bool URunnerTelemetrySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("RunnerTelemetry")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool URunnerTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Ten minutes at 60 fps by default, allocated once so recording does not allocate during the run
+	int32 Frames = 60 * 60 * 10;
+	FString Directory = FPaths::ProjectSavedDir() / TEXT("Telemetry");
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("TelemetryFrames="), Frames);
+	FParse::Value(CommandLine, TEXT("TelemetryDir="), Directory);
+	Recorder.Init(Frames);
+
+	const FString MapName = FPaths::GetBaseFilename(GetWorld()->GetMapName());
+	FilePath = Directory / FString::Printf(TEXT("Runner-%s-%s.rtel"), *MapName, *FDateTime::Now().ToString());
+	Recorder.Session = FString::Printf(TEXT("Map=%s Build=%s CommandLine=%s"), *MapName, FApp::GetBuildVersion(), CommandLine);
+
+	StartTime = FPlatformTime::Seconds();
+}
+
+void URunnerTelemetrySubsystem::Deinitialize()
+{
+	Flush();
+
+	Super::Deinitialize();
+}
+
+TStatId URunnerTelemetrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerTelemetrySubsystem, STATGROUP_Tickables);
+}
+
+void URunnerTelemetrySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	const ARunnerCharacter* MyCharacter = PlayerController ? Cast<ARunnerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (!MyCharacter)
+	{
+		return;
+	}
+
+	// Spawn work is the change of the SpawnObjects counter since the previous frame
+	const int32 SpawnCalls = RunnerCost::SpawnObjects.GetCallCount();
+	const double SpawnSeconds = RunnerCost::SpawnObjects.GetTotalSeconds();
+
+	FRunnerTelemetrySample Sample;
+	Sample.Time = FPlatformTime::Seconds() - StartTime;
+	Sample.FrameTimeMs = DeltaTime * 1000.0f;
+	Sample.Speed = MyCharacter->GetCharacterMovement()->MaxWalkSpeed;
+	const ARunnerGameMode* MyGameMode = World->GetAuthGameMode<ARunnerGameMode>();
+	Sample.TileCount = MyGameMode && MyGameMode->RunnerFloorManager ? MyGameMode->RunnerFloorManager->TileCount : 0;
+	Sample.LiveActors = World->GetActorCount();
+	Sample.SpawnCalls = static_cast<uint16>(FMath::Clamp(SpawnCalls - LastSpawnCalls, 0, MAX_uint16));
+	Sample.SpawnMs = (SpawnSeconds - LastSpawnSeconds) * 1000.0;
+	Sample.bMagnetActive = MyCharacter->bIsMagnetActive;
+	Recorder.Record(Sample);
+
+	LastSpawnCalls = SpawnCalls;
+	LastSpawnSeconds = SpawnSeconds;
+
+	if (MyCharacter->bIsDead && !bWasDead)
+	{
+		Flush();
+	}
+	bWasDead = MyCharacter->bIsDead;
+}
+
+void URunnerTelemetrySubsystem::Flush()
+{
+	if (Recorder.Num() == 0)
+	{
+		return;
+	}
+
+	if (Recorder.SaveToFile(FilePath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("URunnerTelemetrySubsystem: saved %d frames to %s"), Recorder.Num(), *FilePath);
+	}
+}
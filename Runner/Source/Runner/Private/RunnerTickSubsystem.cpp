@@ -0,0 +1,420 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerTickSubsystem.h"
+#include "RunnerGameMode.h"
+#include "RunnerSignificanceSubsystem.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTileManager.h"
+
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "RenderCore.h"
+
+namespace RunnerTickAudit
+{
+	/** Frames skipped after ticks are switched, before frame times are taken */
+	constexpr int32 SettleFrames = 10;
+
+	/** Frames averaged per measurement phase */
+	constexpr int32 SampleFrames = 60;
+
+	/** Classes measured by -RunnerTickAudit */
+	constexpr int32 DefaultMeasureClasses = 10;
+
+#if !UE_BUILD_SHIPPING
+	FAutoConsoleCommandWithWorld AuditCommand(
+		TEXT("Runner.TickAudit"),
+		TEXT("Log the ticking actors and components per class"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (URunnerTickSubsystem* TickSubsystem = World ? World->GetSubsystem<URunnerTickSubsystem>() : nullptr)
+			{
+				TickSubsystem->LogAudit();
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs MeasureCommand(
+		TEXT("Runner.TickAudit.Measure"),
+		TEXT("Estimate the tick cost of the classes with the most ticks, optionally followed by the number of classes"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (URunnerTickSubsystem* TickSubsystem = World ? World->GetSubsystem<URunnerTickSubsystem>() : nullptr)
+			{
+				TickSubsystem->StartMeasure(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : DefaultMeasureClasses);
+			}
+		}));
+#endif
+}
+
+bool URunnerTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URunnerTickSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const URunnerTickSettings* Settings = GetDefault<URunnerTickSettings>();
+	for (const FRunnerTickPolicy& Policy : Settings->Policies)
+	{
+		if (UClass* Class = Policy.Class.LoadSynchronous())
+		{
+			PolicyClasses.Add(Class);
+			ClassPolicies.Add(Policy);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("URunnerTickSubsystem: tick policy class %s not found"), *Policy.Class.ToString());
+		}
+	}
+	DisabledSpawnerTypes = Settings->DisabledSpawnerTypes;
+
+#if !UE_BUILD_SHIPPING
+	if (FParse::Param(FCommandLine::Get(), TEXT("RunnerTickAudit")))
+	{
+		AutoMeasureDelay = 10.0f;
+	}
+#endif
+}
+
+TStatId URunnerTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URunnerTickSubsystem, STATGROUP_Tickables);
+}
+
+const FRunnerTickPolicy* URunnerTickSubsystem::FindPolicy(const UClass* Class)
+{
+	if (const int32* CachedIndex = PolicyCache.Find(Class))
+	{
+		return *CachedIndex != INDEX_NONE ? &ClassPolicies[*CachedIndex] : nullptr;
+	}
+
+	const int32 Index = PolicyClasses.IndexOfByPredicate([Class](const UClass* PolicyClass) { return Class->IsChildOf(PolicyClass); });
+	PolicyCache.Add(Class, Index);
+	return Index != INDEX_NONE ? &ClassPolicies[Index] : nullptr;
+}
+
+void URunnerTickSubsystem::ApplyToActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (Actor->PrimaryActorTick.bCanEverTick)
+	{
+		if (const FRunnerTickPolicy* Policy = FindPolicy(Actor->GetClass()))
+		{
+			if (Policy->Mode == ERunnerTickMode::Disable)
+			{
+				Actor->SetActorTickEnabled(false);
+				++EnforcedCount;
+			}
+			else if (Policy->Mode == ERunnerTickMode::Throttle)
+			{
+				Actor->SetActorTickInterval(Policy->TickInterval);
+				++EnforcedCount;
+			}
+		}
+	}
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (!Component || !Component->PrimaryComponentTick.bCanEverTick)
+		{
+			continue;
+		}
+		if (const FRunnerTickPolicy* Policy = FindPolicy(Component->GetClass()))
+		{
+			if (Policy->Mode == ERunnerTickMode::Disable)
+			{
+				Component->SetComponentTickEnabled(false);
+				++EnforcedCount;
+			}
+			else if (Policy->Mode == ERunnerTickMode::Throttle)
+			{
+				Component->SetComponentTickInterval(Policy->TickInterval);
+				++EnforcedCount;
+			}
+		}
+	}
+}
+
+void URunnerTickSubsystem::ApplyToTile(AActor* Tile)
+{
+	if (!Tile)
+	{
+		return;
+	}
+
+	ApplyToActor(Tile);
+
+	// Spawned objects are handled by their spawner when they are created
+	Tile->ForEachComponent<UChildActorComponent>(false, [this](UChildActorComponent* ChildActorComponent)
+	{
+		if (!ChildActorComponent->GetOuter()->IsA<URunnerSpawnObjectsComponent>())
+		{
+			ApplyToActor(ChildActorComponent->GetChildActor());
+		}
+	});
+}
+
+void URunnerTickSubsystem::ApplyToSpawned(AActor* Actor, ERunnerSpawnerType SpawnerType)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// A class policy takes precedence over the spawner type
+	if (Actor->PrimaryActorTick.bCanEverTick && DisabledSpawnerTypes.Contains(SpawnerType) && !FindPolicy(Actor->GetClass()))
+	{
+		Actor->SetActorTickEnabled(false);
+		++EnforcedCount;
+	}
+
+	ApplyToActor(Actor);
+}
+
+void URunnerTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+#if !UE_BUILD_SHIPPING
+	if (AutoMeasureDelay > 0)
+	{
+		AutoMeasureDelay -= DeltaTime;
+		if (AutoMeasureDelay <= 0)
+		{
+			StartMeasure(RunnerTickAudit::DefaultMeasureClasses);
+		}
+	}
+
+	if (MeasureQueue.Num() == 0)
+	{
+		return;
+	}
+
+	// Frame times of the previous frame, skipped while the change settles
+	++MeasureFrame;
+	if (MeasureFrame > RunnerTickAudit::SettleFrames)
+	{
+		(bMeasuringDisabled ? DisabledMs : BaselineMs) += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	}
+	if (MeasureFrame < RunnerTickAudit::SettleFrames + RunnerTickAudit::SampleFrames)
+	{
+		return;
+	}
+
+	MeasureFrame = 0;
+	if (!bMeasuringDisabled)
+	{
+		bMeasuringDisabled = true;
+		SetMeasuredClassEnabled(false);
+		return;
+	}
+
+	SetMeasuredClassEnabled(true);
+	bMeasuringDisabled = false;
+	if (FTickAuditEntry* Entry = Audit.Find(MeasureQueue[0]))
+	{
+		Entry->MeasuredMs = (BaselineMs - DisabledMs) / RunnerTickAudit::SampleFrames;
+	}
+	BaselineMs = 0;
+	DisabledMs = 0;
+	MeasureQueue.RemoveAt(0);
+
+	if (MeasureQueue.Num() == 0)
+	{
+		LogAudit();
+	}
+#endif
+}
+
+#if !UE_BUILD_SHIPPING
+void URunnerTickSubsystem::GatherAudit()
+{
+	for (TPair<FName, FTickAuditEntry>& Pair : Audit)
+	{
+		Pair.Value.Count = 0;
+		Pair.Value.Enabled = 0;
+		Pair.Value.TicksPerSecond = 0;
+		Pair.Value.MeasurableEnabled = 0;
+		Pair.Value.MeasurableTicksPerSecond = 0;
+	}
+
+	auto AddTick = [this](const UClass* Class, bool bComponent, bool bMeasurable, const FTickFunction& TickFunction)
+	{
+		FTickAuditEntry& Entry = Audit.FindOrAdd(Class->GetFName());
+		Entry.Class = Class->GetFName();
+		Entry.bComponent = bComponent;
+		++Entry.Count;
+		if (TickFunction.IsTickFunctionEnabled())
+		{
+			const float Interval = TickFunction.TickInterval;
+			const double TicksPerSecond = Interval > 0 ? 1.0 / Interval : 1.0 / FMath::Max(FApp::GetDeltaTime(), UE_KINDA_SMALL_NUMBER);
+			++Entry.Enabled;
+			Entry.TicksPerSecond += TicksPerSecond;
+			if (bMeasurable)
+			{
+				++Entry.MeasurableEnabled;
+				Entry.MeasurableTicksPerSecond += TicksPerSecond;
+			}
+		}
+	};
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		const bool bMeasurable = IsMeasurable(*It);
+		if (It->PrimaryActorTick.bCanEverTick)
+		{
+			AddTick(It->GetClass(), false, bMeasurable, It->PrimaryActorTick);
+		}
+		for (const UActorComponent* Component : It->GetComponents())
+		{
+			if (Component && Component->PrimaryComponentTick.bCanEverTick)
+			{
+				AddTick(Component->GetClass(), true, bMeasurable, Component->PrimaryComponentTick);
+			}
+		}
+	}
+}
+
+void URunnerTickSubsystem::LogAudit()
+{
+	GatherAudit();
+
+	TArray<FTickAuditEntry> Entries;
+	Audit.GenerateValueArray(Entries);
+	Entries.RemoveAll([](const FTickAuditEntry& Entry) { return Entry.Count == 0; });
+	Entries.Sort([](const FTickAuditEntry& A, const FTickAuditEntry& B) { return A.Enabled > B.Enabled; });
+
+	int32 TotalEnabled = 0;
+	for (const FTickAuditEntry& Entry : Entries)
+	{
+		TotalEnabled += Entry.Enabled;
+	}
+	UE_LOG(LogTemp, Display, TEXT("URunnerTickSubsystem: %d ticking classes, %d enabled ticks, %d ticks changed by policies"), Entries.Num(), TotalEnabled, EnforcedCount);
+
+	for (const FTickAuditEntry& Entry : Entries)
+	{
+		const FString Cost = Entry.MeasuredMs >= 0
+			? FString::Printf(TEXT("%.3f ms/frame, %.4f ms/tick"), Entry.MeasuredMs, Entry.MeasurableEnabled > 0 ? Entry.MeasuredMs / Entry.MeasurableEnabled : 0)
+			: FString(TEXT("not measured"));
+		UE_LOG(LogTemp, Display, TEXT("URunnerTickSubsystem:   %-48s %-9s %5d can tick, %5d enabled, %7.0f ticks/s, %s"),
+			*Entry.Class.ToString(), Entry.bComponent ? TEXT("component") : TEXT("actor"), Entry.Count, Entry.Enabled, Entry.TicksPerSecond, *Cost);
+	}
+}
+
+void URunnerTickSubsystem::StartMeasure(int32 MaxClasses)
+{
+	if (MeasureQueue.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URunnerTickSubsystem: a measurement is already running"));
+		return;
+	}
+
+	GatherAudit();
+
+	TArray<FTickAuditEntry> Entries;
+	Audit.GenerateValueArray(Entries);
+	Entries.RemoveAll([](const FTickAuditEntry& Entry) { return Entry.MeasurableEnabled == 0; });
+	Entries.Sort([](const FTickAuditEntry& A, const FTickAuditEntry& B) { return A.MeasurableTicksPerSecond > B.MeasurableTicksPerSecond; });
+	for (int32 Index = 0; Index < FMath::Min(MaxClasses, Entries.Num()); ++Index)
+	{
+		MeasureQueue.Add(Entries[Index].Class);
+	}
+
+	MeasureFrame = 0;
+	bMeasuringDisabled = false;
+	BaselineMs = 0;
+	DisabledMs = 0;
+	UE_LOG(LogTemp, Display, TEXT("URunnerTickSubsystem: measuring %d classes, ticks of each class on tiles and spawned objects are disabled for %d frames"),
+		MeasureQueue.Num(), RunnerTickAudit::SettleFrames + RunnerTickAudit::SampleFrames);
+}
+
+bool URunnerTickSubsystem::IsMeasurable(const AActor* Actor) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!Actor || Actor == PlayerController || (PlayerController && Actor == PlayerController->GetPawn()))
+	{
+		return false;
+	}
+
+	// Spawned objects and the child actors of a tile lead up to the tile through their parent actors
+	const AActor* Tile = Actor;
+	while (const AActor* Parent = Tile->GetParentActor())
+	{
+		Tile = Parent;
+	}
+	const ARunnerGameMode* MyGameMode = GetWorld()->GetAuthGameMode<ARunnerGameMode>();
+	return MyGameMode
+		&& ((MyGameMode->RunnerFloorManager && MyGameMode->RunnerFloorManager->GetTileActors().Contains(Tile))
+			|| (MyGameMode->RunnerSkylineManager && MyGameMode->RunnerSkylineManager->GetTileActors().Contains(Tile)));
+}
+
+void URunnerTickSubsystem::SetMeasuredClassEnabled(bool bEnabled)
+{
+	if (bEnabled)
+	{
+		// Tiers may have changed during the measurement, tracked objects get the ticks of their current tier
+		URunnerSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<URunnerSignificanceSubsystem>();
+		TSet<AActor*> RefreshedActors;
+		for (const TWeakObjectPtr<UObject>& Object : MeasureDisabled)
+		{
+			AActor* Actor = Cast<AActor>(Object.Get());
+			UActorComponent* Component = Cast<UActorComponent>(Object.Get());
+			AActor* Owner = Actor ? Actor : (Component ? Component->GetOwner() : nullptr);
+			if (!Owner)
+			{
+				continue;
+			}
+			if (RefreshedActors.Contains(Owner) || (SignificanceSubsystem && SignificanceSubsystem->RefreshTier(Owner)))
+			{
+				RefreshedActors.Add(Owner);
+				continue;
+			}
+
+			// Only enabled ticks were disabled, so enabled is the previous state
+			if (Actor)
+			{
+				Actor->SetActorTickEnabled(true);
+			}
+			else
+			{
+				Component->SetComponentTickEnabled(true);
+			}
+		}
+		MeasureDisabled.Reset();
+		return;
+	}
+
+	// Only ticks that are enabled now are disabled, so restoring them keeps the policies intact
+	const FName MeasuredClass = MeasureQueue[0];
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		if (!IsMeasurable(*It))
+		{
+			continue;
+		}
+		if (It->GetClass()->GetFName() == MeasuredClass && It->IsActorTickEnabled())
+		{
+			It->SetActorTickEnabled(false);
+			MeasureDisabled.Add(*It);
+		}
+		for (UActorComponent* Component : It->GetComponents())
+		{
+			if (Component && Component->GetClass()->GetFName() == MeasuredClass && Component->IsComponentTickEnabled())
+			{
+				Component->SetComponentTickEnabled(false);
+				MeasureDisabled.Add(Component);
+			}
+		}
+	}
+}
+#endif
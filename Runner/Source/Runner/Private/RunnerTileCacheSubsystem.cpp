@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerTileCacheSubsystem.h"
+#include "RunnerCollisionInterface.h"
+#include "RunnerSpawnLayout.h"
+
+#include "Components/ChildActorComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/StaticMesh.h"
+
+namespace RunnerTileCache
+{
+	/** Returns the parent of a component in the class defaults, nullptr for the root */
+	const USceneComponent* FindTemplateParent(UClass* ActorClass, const USceneComponent* Component)
+	{
+		// Native components are attached on the class default object
+		if (const USceneComponent* AttachParent = Component->GetAttachParent())
+		{
+			return AttachParent;
+		}
+
+		// Components added in Blueprints keep their parent in the construction script
+		AActor* ActorDefaults = ActorClass->GetDefaultObject<AActor>();
+		UBlueprintGeneratedClass* ActorBPGC = Cast<UBlueprintGeneratedClass>(ActorClass);
+		for (UBlueprintGeneratedClass* BPGC = ActorBPGC; BPGC; BPGC = Cast<UBlueprintGeneratedClass>(BPGC->GetSuperClass()))
+		{
+			const USimpleConstructionScript* SCS = BPGC->SimpleConstructionScript;
+			if (!SCS)
+			{
+				continue;
+			}
+			for (const USCS_Node* Node : SCS->GetAllNodes())
+			{
+				if (!Node || Node->GetActualComponentTemplate(ActorBPGC) != Component)
+				{
+					continue;
+				}
+				if (const USCS_Node* ParentNode = SCS->FindParentNode(const_cast<USCS_Node*>(Node)))
+				{
+					return Cast<USceneComponent>(ParentNode->GetActualComponentTemplate(ActorBPGC));
+				}
+				if (Node->ParentComponentOrVariableName != NAME_None)
+				{
+					if (Node->bIsParentComponentNative)
+					{
+						return Cast<USceneComponent>(ActorDefaults->GetDefaultSubobjectByName(Node->ParentComponentOrVariableName));
+					}
+					for (UBlueprintGeneratedClass* ParentBPGC = Cast<UBlueprintGeneratedClass>(BPGC->GetSuperClass()); ParentBPGC; ParentBPGC = Cast<UBlueprintGeneratedClass>(ParentBPGC->GetSuperClass()))
+					{
+						const USCS_Node* ParentNode = ParentBPGC->SimpleConstructionScript ? ParentBPGC->SimpleConstructionScript->FindSCSNode(Node->ParentComponentOrVariableName) : nullptr;
+						if (ParentNode)
+						{
+							return Cast<USceneComponent>(ParentNode->GetActualComponentTemplate(ActorBPGC));
+						}
+					}
+				}
+
+				// Root nodes are attached to the native root if the class has one
+				return ActorDefaults->GetRootComponent();
+			}
+		}
+		return nullptr;
+	}
+
+	/** Returns the transform of a component relative to the spawn transform of its actor, spawning only keeps the scale of the root */
+	FTransform GetSpawnRelativeTransform(UClass* ActorClass, const USceneComponent* Component)
+	{
+		FTransform Transform = FTransform::Identity;
+		for (const USceneComponent* Current = Component; Current; )
+		{
+			const USceneComponent* Parent = FindTemplateParent(ActorClass, Current);
+			if (!Parent)
+			{
+				Transform = Transform * FTransform(Current->GetRelativeScale3D());
+				break;
+			}
+			Transform = Transform * Current->GetRelativeTransform();
+			Current = Parent;
+		}
+		return Transform;
+	}
+}
+
+bool URunnerTileCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FVector URunnerTileCacheSubsystem::ComputeFloorExtent(const UChildActorComponent* AttachParent)
+{
+	FVector FloorExtent = FVector::ZeroVector;
+
+	if (IsValid(AttachParent) && IsValid(AttachParent->GetChildActor()))
+	{
+		// Now access the StaticMeshComponent of the child actor
+		const UStaticMeshComponent* StaticMeshComp = AttachParent->GetChildActor()->FindComponentByClass<UStaticMeshComponent>();
+		if (IsValid(StaticMeshComp) && StaticMeshComp->GetStaticMesh())
+		{
+			const FVector MeshExtent = StaticMeshComp->GetStaticMesh()->GetBoundingBox().GetExtent();
+			const FVector ComponentScale = StaticMeshComp->GetComponentScale();
+			FloorExtent = MeshExtent * ComponentScale;
+		}
+	}
+
+	return FloorExtent;
+}
+
+FVector URunnerTileCacheSubsystem::GetFloorExtent(const UChildActorComponent* AttachParent)
+{
+	if (!IsValid(AttachParent))
+	{
+		return FVector::ZeroVector;
+	}
+
+	const TPair<FObjectKey, FVector> Key(AttachParent->GetChildActorClass().Get(), AttachParent->GetComponentScale());
+	if (const FVector* FloorExtent = FloorExtents.Find(Key))
+	{
+		return *FloorExtent;
+	}
+
+	// A child actor that is not spawned yet has no extent, it is not cached
+	const FVector FloorExtent = ComputeFloorExtent(AttachParent);
+	if (!FloorExtent.IsZero())
+	{
+		FloorExtents.Add(Key, FloorExtent);
+	}
+	return FloorExtent;
+}
+
+FVector URunnerTileCacheSubsystem::GetAttachOffset(AActor* Tile)
+{
+	if (!Tile)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FObjectKey Key(Tile->GetClass());
+	if (const FVector* AttachOffset = AttachOffsets.Find(Key))
+	{
+		return *AttachOffset;
+	}
+
+	// Tiles are spawned without rotation, so the offset from the first tile holds for every tile of the class
+	FVector AttachOffset = FVector::ZeroVector;
+	if (Tile->GetClass()->ImplementsInterface(URunnerCollisionInterface::StaticClass()))
+	{
+		AttachOffset = IRunnerCollisionInterface::Execute_GetAttachLocation(Tile) - Tile->GetActorLocation();
+	}
+	AttachOffsets.Add(Key, AttachOffset);
+	return AttachOffset;
+}
+
+uint32 URunnerTileCacheSubsystem::HashGridLayout(const FSpawnSettings& Settings, const FVector& FloorExtent)
+{
+	uint32 Hash = GetTypeHash(FloorExtent);
+	Hash = HashCombine(Hash, GetTypeHash(Settings.PointsPerLane));
+	Hash = HashCombine(Hash, GetTypeHash(Settings.XOffset));
+	Hash = HashCombine(Hash, GetTypeHash(Settings.ZOffset));
+	Hash = HashCombine(Hash, GetTypeHash(Settings.ActorRotator.Pitch));
+	Hash = HashCombine(Hash, GetTypeHash(Settings.ActorRotator.Yaw));
+	Hash = HashCombine(Hash, GetTypeHash(Settings.ActorRotator.Roll));
+	for (const float LaneYOffset : Settings.LaneYOffsets)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(LaneYOffset));
+	}
+	return Hash;
+}
+
+bool URunnerTileCacheSubsystem::FSpawnGridEntry::Matches(const FSpawnSettings& Settings, const FVector& InFloorExtent) const
+{
+	return FloorExtent == InFloorExtent
+		&& PointsPerLane == Settings.PointsPerLane
+		&& XOffset == Settings.XOffset
+		&& ZOffset == Settings.ZOffset
+		&& ActorRotator == Settings.ActorRotator
+		&& LaneYOffsets == Settings.LaneYOffsets;
+}
+
+TConstArrayView<FTransform> URunnerTileCacheSubsystem::GetSpawnGrid(const FSpawnSettings& Settings, const FVector& FloorExtent)
+{
+	const uint32 Hash = HashGridLayout(Settings, FloorExtent);
+	if (const FSpawnGridEntry* Entry = SpawnGrids.Find(Hash))
+	{
+		if (Entry->Matches(Settings, FloorExtent))
+		{
+			return Entry->Grid;
+		}
+
+		// Another layout owns the hash, generate without caching
+		RunnerSpawnLayout::GenerateSpawnGrid(Settings, FloorExtent, UncachedGrid);
+		return UncachedGrid;
+	}
+
+	FSpawnGridEntry& Entry = SpawnGrids.Add(Hash);
+	Entry.FloorExtent = FloorExtent;
+	Entry.PointsPerLane = Settings.PointsPerLane;
+	Entry.XOffset = Settings.XOffset;
+	Entry.ZOffset = Settings.ZOffset;
+	Entry.ActorRotator = Settings.ActorRotator;
+	Entry.LaneYOffsets = Settings.LaneYOffsets;
+	RunnerSpawnLayout::GenerateSpawnGrid(Settings, FloorExtent, Entry.Grid);
+	return Entry.Grid;
+}
+
+const URunnerTileCacheSubsystem::FProxyMesh* URunnerTileCacheSubsystem::GetProxyMesh(UClass* ActorClass)
+{
+	if (!ActorClass || !ActorClass->IsChildOf(AActor::StaticClass()))
+	{
+		return nullptr;
+	}
+
+	const FObjectKey Key(ActorClass);
+	FProxyMesh* ProxyMesh = ProxyMeshes.Find(Key);
+	if (!ProxyMesh)
+	{
+		// Includes the components added in Blueprints
+		ProxyMesh = &ProxyMeshes.Add(Key);
+		AActor::ForEachComponentOfActorClassDefault<UStaticMeshComponent>(ActorClass, [ActorClass, ProxyMesh](const UStaticMeshComponent* Component)
+		{
+			if (!Component->GetStaticMesh())
+			{
+				return true;
+			}
+			ProxyMesh->Mesh = Component->GetStaticMesh();
+			ProxyMesh->RelativeTransform = RunnerTileCache::GetSpawnRelativeTransform(ActorClass, Component);
+			return false;
+		});
+	}
+	return ProxyMesh->Mesh ? ProxyMesh : nullptr;
+}
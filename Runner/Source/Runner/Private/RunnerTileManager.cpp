@@ -4,9 +4,57 @@
 #include "RunnerTileManager.h"
 #include "UObject/Interface.h"
 #include "RunnerCollisionInterface.h"
+#include "RunnerProfiling.h"
+#include "RunnerSpawnObjectsComponent.h"
+#include "RunnerTickSubsystem.h"
+#include "RunnerTileCacheSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("ExtendTile"), STAT_RunnerExtendTile, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("AddTile"), STAT_RunnerAddTile, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("RemoveTile"), STAT_RunnerRemoveTile, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("MaterializeTiles"), STAT_RunnerMaterializeTiles, STATGROUP_Runner);
+DECLARE_CYCLE_STAT(TEXT("ReclaimPassedObjects"), STAT_RunnerReclaimPassedObjects, STATGROUP_Runner);
+
+URunnerTileManager::URunnerTileManager()
+{
+	// Only ticks while tiles wait for their objects or passed objects are reclaimed
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void URunnerTileManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (PendingTiles.Num() > 0)
+	{
+		MaterializeTiles();
+	}
+
+	if (ReclaimDistance > 0)
+	{
+		TimeUntilReclaim -= DeltaTime;
+		if (TimeUntilReclaim <= 0)
+		{
+			TimeUntilReclaim = ReclaimInterval;
+			ReclaimPassedObjects();
+		}
+	}
+	else if (PendingTiles.Num() == 0)
+	{
+		// Nothing to do until the next far tile
+		SetComponentTickEnabled(false);
+	}
+}
 
 void URunnerTileManager::ExtendTile()
 {
+	RUNNER_SCOPE_COST(ExtendTile);
+	RUNNER_SCOPE_CYCLE(STAT_RunnerExtendTile);
+
 	AddTile();
 	
 	if (TileActorArray.Num() > TilesAheadPlayer + TilesBehindPlayer)
@@ -18,6 +66,12 @@ void URunnerTileManager::ExtendTile()
 void URunnerTileManager::InitiateTile()
 {
 	TileAttachLocation = FirstTileLocation;
+	RandomStream.Initialize(RandomSeed != 0 ? RandomSeed : FMath::Rand());
+
+	if (ReclaimDistance > 0)
+	{
+		SetComponentTickEnabled(true);
+	}
 	
 	for(int32 i=0; i < TilesAheadPlayer; i++)
 	{
@@ -27,6 +81,10 @@ void URunnerTileManager::InitiateTile()
 
 void URunnerTileManager::AddTile()
 {
+	RUNNER_SCOPE_COST(AddTile);
+	RUNNER_SCOPE_CYCLE(STAT_RunnerAddTile);
+	RUNNER_LLM_SCOPE_BYNAME(GetMemoryTag());
+
 	if (TileClass)
 	{
 		if (TileClass->ImplementsInterface(URunnerCollisionInterface::StaticClass()))
@@ -38,9 +96,36 @@ void URunnerTileManager::AddTile()
 				//UE_LOG(LogTemp, Display, TEXT("Adding tile to world at position: %s"), *TileAttachLocation.ToString());
 				TileActorArray.Add(NewFloorActor);
 				TileCount++;
+
+				if (URunnerTickSubsystem* TickSubsystem = GetWorld()->GetSubsystem<URunnerTickSubsystem>())
+				{
+					TickSubsystem->ApplyToTile(NewFloorActor);
+				}
+
+				// Mark progress in Insights captures
+				if (TileCount % 100 == 0)
+				{
+					TRACE_BOOKMARK(TEXT("%s tile %d"), *GetName(), TileCount);
+				}
 				
-				IRunnerCollisionInterface* I = Cast<IRunnerCollisionInterface>(NewFloorActor);
-				if (I)
+				// Far tiles planned their objects while being spawned
+				bool bHasPlannedObjects = false;
+				NewFloorActor->ForEachComponent<URunnerSpawnObjectsComponent>(false, [&bHasPlannedObjects](const URunnerSpawnObjectsComponent* Spawner)
+				{
+					bHasPlannedObjects |= Spawner->HasPlannedObjects();
+				});
+				if (bHasPlannedObjects)
+				{
+					PendingTiles.Add(NewFloorActor);
+					SetComponentTickEnabled(true);
+				}
+
+				// The attach point is the same for every tile of the class, only the first tile is asked for it
+				if (URunnerTileCacheSubsystem* TileCache = GetWorld()->GetSubsystem<URunnerTileCacheSubsystem>())
+				{
+					TileAttachLocation = NewFloorActor->GetActorLocation() + TileCache->GetAttachOffset(NewFloorActor);
+				}
+				else if (IRunnerCollisionInterface* I = Cast<IRunnerCollisionInterface>(NewFloorActor))
 				{
 					TileAttachLocation = I->Execute_GetAttachLocation(NewFloorActor);
 				}
@@ -59,6 +144,10 @@ void URunnerTileManager::AddTile()
 
 void URunnerTileManager::RemoveTile()
 {
+	RUNNER_SCOPE_COST(RemoveTile);
+	RUNNER_SCOPE_CYCLE(STAT_RunnerRemoveTile);
+	RUNNER_LLM_SCOPE_BYNAME(GetMemoryTag());
+
 	if (TileActorArray.Num() > 0)
 	{
 		const int32 Index = 0;
@@ -67,3 +156,92 @@ void URunnerTileManager::RemoveTile()
 		TileActorArray.RemoveAt(Index);
 	}
 }
+
+bool URunnerTileManager::ShouldDeferObjects(const FVector& TileLocation) const
+{
+	return MaterializeDistance > 0 && GetWorld()->IsGameWorld() && TileLocation.X - GetPlayerTrackX() > MaterializeDistance;
+}
+
+double URunnerTileManager::GetPlayerTrackX() const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APawn* Player = PlayerController ? PlayerController->GetPawn() : nullptr;
+	return Player ? Player->GetActorLocation().X : FirstTileLocation.X;
+}
+
+void URunnerTileManager::MaterializeTiles()
+{
+	RUNNER_SCOPE_CYCLE(STAT_RunnerMaterializeTiles);
+	RUNNER_LLM_SCOPE_BYNAME(GetMemoryTag());
+
+	const double PlayerX = GetPlayerTrackX();
+	int32 Materialized = 0;
+	while (PendingTiles.Num() > 0)
+	{
+		AActor* Tile = PendingTiles[0].Get();
+		if (!Tile)
+		{
+			PendingTiles.RemoveAt(0);
+			continue;
+		}
+
+		const double Distance = Tile->GetActorLocation().X - PlayerX;
+		if (Distance > MaterializeDistance)
+		{
+			break;
+		}
+
+		// Spread the spawns over frames, unless the player is about to reach the tile
+		const bool bUrgent = Distance <= MaterializeDistance * 0.5f;
+		bool bDone = true;
+		Tile->ForEachComponent<URunnerSpawnObjectsComponent>(false, [this, bUrgent, &Materialized, &bDone](URunnerSpawnObjectsComponent* Spawner)
+		{
+			if (!Spawner->HasPlannedObjects())
+			{
+				return;
+			}
+			if (!bUrgent && Materialized >= MaterializeSpawnersPerFrame)
+			{
+				bDone = false;
+				return;
+			}
+			Spawner->MaterializeObjects();
+			++Materialized;
+		});
+
+		if (!bDone)
+		{
+			break;
+		}
+		PendingTiles.RemoveAt(0);
+	}
+}
+
+void URunnerTileManager::ReclaimPassedObjects()
+{
+	RUNNER_SCOPE_CYCLE(STAT_RunnerReclaimPassedObjects);
+	RUNNER_LLM_SCOPE_BYNAME(GetMemoryTag());
+
+	// Moving objects can pass the player from any tile, so every tile is checked
+	const double ReclaimX = GetPlayerTrackX() - ReclaimDistance;
+	for (AActor* Tile : TileActorArray)
+	{
+		if (!Tile)
+		{
+			continue;
+		}
+		Tile->ForEachComponent<URunnerSpawnObjectsComponent>(false, [this, ReclaimX](URunnerSpawnObjectsComponent* Spawner)
+		{
+			ReclaimedCount += Spawner->ReclaimObjectsBehind(ReclaimX);
+		});
+	}
+}
+
+FName URunnerTileManager::GetMemoryTag() const
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	return bIsSkyline ? LLM_TAG_NAME(Runner_Skyline) : LLM_TAG_NAME(Runner_Tiles);
+#else
+	return NAME_None;
+#endif
+}
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerWidgetManager.h"
+
+#include "RunnerGameMode.h"
+#include "RunnerProfiling.h"
+#include "Blueprint/UserWidget.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("CreateWidget"), STAT_RunnerCreateWidget, STATGROUP_Runner);
+
+URunnerWidgetManager::URunnerWidgetManager()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+UUserWidget* URunnerWidgetManager::ShowWidget(TSubclassOf<UUserWidget> WidgetClass, int32 Layer, bool bReconstruct)
+{
+	UUserWidget* Widget = GetOrCreateWidget(WidgetClass);
+	if (!Widget)
+	{
+		return nullptr;
+	}
+
+	// The Z-order is only set when adding to the viewport, and Construct only runs then
+	if (Widget->IsInViewport())
+	{
+		const int32* ShownLayer = WidgetLayers.Find(WidgetClass);
+		const bool bLayerChanged = !ShownLayer || *ShownLayer != Layer;
+		if (bLayerChanged || (bReconstruct && !Widget->IsVisible()))
+		{
+			Widget->RemoveFromParent();
+		}
+	}
+
+	// Widgets may remove themselves from the viewport, add them back on the requested layer
+	if (!Widget->IsInViewport())
+	{
+		Widget->AddToViewport(Layer);
+		WidgetLayers.Add(WidgetClass, Layer);
+	}
+
+	// Restore the default user widget visibility when it was hidden
+	if (!Widget->IsVisible())
+	{
+		Widget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+	}
+	return Widget;
+}
+
+void URunnerWidgetManager::HideWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (UUserWidget* Widget = FindWidget(WidgetClass))
+	{
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+bool URunnerWidgetManager::IsWidgetVisible(TSubclassOf<UUserWidget> WidgetClass) const
+{
+	const UUserWidget* Widget = FindWidget(WidgetClass);
+	return Widget && Widget->IsInViewport() && Widget->IsVisible();
+}
+
+UUserWidget* URunnerWidgetManager::FindWidget(TSubclassOf<UUserWidget> WidgetClass) const
+{
+	const TObjectPtr<UUserWidget>* Widget = CachedWidgets.Find(WidgetClass);
+	return Widget ? Widget->Get() : nullptr;
+}
+
+void URunnerWidgetManager::PrecreateWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+	GetOrCreateWidget(WidgetClass);
+}
+
+void URunnerWidgetManager::ReportWidgets() const
+{
+	int32 LiveWidgetCount = 0;
+	for (TObjectIterator<UUserWidget> It; It; ++It)
+	{
+		if (It->GetWorld() == GetWorld())
+		{
+			++LiveWidgetCount;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("URunnerWidgetManager: %d cached widgets, %d live user widgets in world"), CachedWidgets.Num(), LiveWidgetCount);
+	for (const TPair<TSubclassOf<UUserWidget>, TObjectPtr<UUserWidget>>& Pair : CachedWidgets)
+	{
+		if (Pair.Value)
+		{
+			UE_LOG(LogTemp, Display, TEXT("  %s InViewport=%d Visible=%d"), *GetNameSafe(Pair.Key), Pair.Value->IsInViewport(), Pair.Value->IsVisible());
+		}
+	}
+}
+
+void URunnerWidgetManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const TPair<TSubclassOf<UUserWidget>, TObjectPtr<UUserWidget>>& Pair : CachedWidgets)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->RemoveFromParent();
+		}
+	}
+	CachedWidgets.Empty();
+	WidgetLayers.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UUserWidget* URunnerWidgetManager::GetOrCreateWidget(const TSubclassOf<UUserWidget>& WidgetClass)
+{
+	if (!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	if (UUserWidget* Widget = FindWidget(WidgetClass))
+	{
+		return Widget;
+	}
+
+	RUNNER_SCOPE_COST(CreateWidget);
+	RUNNER_SCOPE_CYCLE(STAT_RunnerCreateWidget);
+	LLM_SCOPE_BYTAG(Runner_UI);
+	UUserWidget* Widget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+	if (!Widget)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to create widget %s"), *WidgetClass->GetName());
+		return nullptr;
+	}
+
+	CachedWidgets.Add(WidgetClass, Widget);
+	return Widget;
+}
+
+/** Console command to report widget counts */
+static FAutoConsoleCommandWithWorld GRunnerReportWidgetsCommand(
+	TEXT("Runner.ReportWidgets"),
+	TEXT("Log cached and live user widgets"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ARunnerGameMode* MyGameMode = World ? Cast<ARunnerGameMode>(World->GetAuthGameMode()) : nullptr)
+		{
+			MyGameMode->RunnerWidgetManager->ReportWidgets();
+		}
+	}));
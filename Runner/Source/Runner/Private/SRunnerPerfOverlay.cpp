@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SRunnerPerfOverlay.h"
+
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+namespace RunnerPerfOverlayLayout
+{
+	constexpr float Padding = 6;
+	constexpr float GraphWidth = 360;
+	constexpr float GraphHeight = 80;
+	constexpr float LineHeight = 14;
+
+	/** Frame time at the top of the graph */
+	constexpr float GraphMaxMs = 50;
+}
+
+void SRunnerPerfOverlay::Construct(const FArguments& InArgs)
+{
+	Data = InArgs._Data;
+	Font = FCoreStyle::GetDefaultFontStyle("Mono", 9);
+	SetVisibility(EVisibility::HitTestInvisible);
+}
+
+FVector2D SRunnerPerfOverlay::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	using namespace RunnerPerfOverlayLayout;
+	const int32 LineCount = Data ? Data->Lines.Num() : 0;
+	return FVector2D(GraphWidth + 2 * Padding, GraphHeight + LineCount * LineHeight + 3 * Padding);
+}
+
+int32 SRunnerPerfOverlay::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	using namespace RunnerPerfOverlayLayout;
+	if (!Data)
+	{
+		return LayerId;
+	}
+
+	// Background
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(),
+		FCoreStyle::Get().GetBrush("GenericWhiteBox"), ESlateDrawEffect::None, FLinearColor(0, 0, 0, 0.6f));
+
+	// Reference lines at 60 and 30 fps
+	const FVector2D GraphOrigin(Padding, Padding);
+	auto GraphY = [&GraphOrigin](float Ms)
+	{
+		return GraphOrigin.Y + GraphHeight * (1 - FMath::Min(Ms / GraphMaxMs, 1.0f));
+	};
+	for (const float ReferenceMs : {1000.0f / 60, 1000.0f / 30})
+	{
+		GraphPoints.Reset();
+		GraphPoints.Add(FVector2D(GraphOrigin.X, GraphY(ReferenceMs)));
+		GraphPoints.Add(FVector2D(GraphOrigin.X + GraphWidth, GraphY(ReferenceMs)));
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(), GraphPoints,
+			ESlateDrawEffect::None, FLinearColor(1, 1, 1, 0.25f));
+	}
+
+	// Frame times, oldest on the left
+	const int32 FrameCount = Data->FrameTimesMs.Num();
+	if (FrameCount > 1)
+	{
+		GraphPoints.Reset();
+		for (int32 Index = 0; Index < FrameCount; ++Index)
+		{
+			const float Ms = Data->FrameTimesMs[(Data->FrameHead + Index) % FrameCount];
+			GraphPoints.Add(FVector2D(GraphOrigin.X + GraphWidth * Index / (FrameCount - 1), GraphY(Ms)));
+		}
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 2, AllottedGeometry.ToPaintGeometry(), GraphPoints,
+			ESlateDrawEffect::None, FLinearColor::Green);
+	}
+
+	// Text
+	FVector2D TextPosition(Padding, 2 * Padding + GraphHeight);
+	for (const FString& Line : Data->Lines)
+	{
+		FSlateDrawElement::MakeText(OutDrawElements, LayerId + 2,
+			AllottedGeometry.ToPaintGeometry(FVector2D(GraphWidth, LineHeight), FSlateLayoutTransform(TextPosition)),
+			Line, Font, ESlateDrawEffect::None, FLinearColor::White);
+		TextPosition.Y += LineHeight;
+	}
+
+	return LayerId + 2;
+}
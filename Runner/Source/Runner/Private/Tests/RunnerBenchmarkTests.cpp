@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerBenchmarkSubsystem.h"
+#include "RunnerPerfBaselines.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RunnerBenchmarkTests
+{
+	/** Returns a report with the fields read by the baseline gate, frame and game thread times are constant */
+	TSharedRef<FJsonObject> MakeReport(float FrameTimeMs, bool bWithGameThread)
+	{
+		TArray<float> FrameTimes;
+		FrameTimes.Init(FrameTimeMs, 100);
+
+		TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+		Metrics->SetObjectField(TEXT("FrameTimeMs"), URunnerBenchmarkSubsystem::MakeDistribution(FrameTimes));
+		if (bWithGameThread)
+		{
+			Metrics->SetObjectField(TEXT("GameThreadMs"), URunnerBenchmarkSubsystem::MakeDistribution(FrameTimes));
+		}
+
+		TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetStringField(TEXT("Build"), TEXT("Test"));
+		Report->SetNumberField(TEXT("Changelist"), 0);
+		Report->SetObjectField(TEXT("Metrics"), Metrics);
+		return Report;
+	}
+
+	const FRunnerPerfMetricResult* FindResult(const TArray<FRunnerPerfMetricResult>& Results, const TCHAR* Name)
+	{
+		return Results.FindByPredicate([Name](const FRunnerPerfMetricResult& Result) { return Result.Name == Name; });
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerBenchmarkDistributionTest, "Runner.Benchmark.Distribution",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerBenchmarkDistributionTest::RunTest(const FString& Parameters)
+{
+	// Unsorted samples 1 to 100, so the percentiles are the sample values
+	TArray<float> Samples;
+	for (int32 Value = 100; Value >= 1; --Value)
+	{
+		Samples.Add(Value);
+	}
+
+	const TSharedRef<FJsonObject> Distribution = URunnerBenchmarkSubsystem::MakeDistribution(Samples);
+	TestEqual(TEXT("Count"), Distribution->GetNumberField(TEXT("Count")), 100.0);
+	TestEqual(TEXT("Mean"), Distribution->GetNumberField(TEXT("Mean")), 50.5);
+	TestEqual(TEXT("P50"), Distribution->GetNumberField(TEXT("P50")), 50.0);
+	TestEqual(TEXT("P95"), Distribution->GetNumberField(TEXT("P95")), 95.0);
+	TestEqual(TEXT("P99"), Distribution->GetNumberField(TEXT("P99")), 99.0);
+	TestEqual(TEXT("Max"), Distribution->GetNumberField(TEXT("Max")), 100.0);
+
+	// A single sample is every percentile
+	const TSharedRef<FJsonObject> Single = URunnerBenchmarkSubsystem::MakeDistribution({ 7.0f });
+	TestEqual(TEXT("Single P50"), Single->GetNumberField(TEXT("P50")), 7.0);
+	TestEqual(TEXT("Single P99"), Single->GetNumberField(TEXT("P99")), 7.0);
+
+	// No samples only reports the count
+	const TSharedRef<FJsonObject> Empty = URunnerBenchmarkSubsystem::MakeDistribution({});
+	TestEqual(TEXT("Empty count"), Empty->GetNumberField(TEXT("Count")), 0.0);
+	TestFalse(TEXT("Empty has no P95"), Empty->HasField(TEXT("P95")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerBenchmarkResultTest, "Runner.Benchmark.Result",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerBenchmarkResultTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Short of the distance before the timeout runs on"),
+		URunnerBenchmarkSubsystem::GetResult(1000, 10, 2000, 900) == ERunnerBenchmarkResult::Running);
+	TestTrue(TEXT("Reaching the distance succeeds"),
+		URunnerBenchmarkSubsystem::GetResult(2000, 10, 2000, 900) == ERunnerBenchmarkResult::Succeeded);
+	TestTrue(TEXT("Short of the distance at the timeout fails"),
+		URunnerBenchmarkSubsystem::GetResult(1999, 900, 2000, 900) == ERunnerBenchmarkResult::TimedOut);
+	TestTrue(TEXT("Reaching the distance at the timeout succeeds"),
+		URunnerBenchmarkSubsystem::GetResult(2000, 900, 2000, 900) == ERunnerBenchmarkResult::Succeeded);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerBenchmarkBaselineTest, "Runner.Benchmark.BaselineThresholds",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerBenchmarkBaselineTest::RunTest(const FString& Parameters)
+{
+	using namespace RunnerBenchmarkTests;
+
+	FRunnerPerfBaselines Baselines;
+	Baselines.SetBaseline(TEXT("Test"), *MakeReport(10, true));
+	TArray<FRunnerPerfMetricResult> Results;
+
+	// The same run passes
+	TestTrue(TEXT("Compare with the same run"), Baselines.Compare(TEXT("Test"), *MakeReport(10, true), Results));
+	TestFalse(TEXT("Same run regressed"), Results.ContainsByPredicate([](const FRunnerPerfMetricResult& Result) { return Result.bRegressed; }));
+
+	// FrameTimeMs.P50 allows 10% and FrameTimeMs.P95 15%, both ignore changes below 0.5 ms
+	Baselines.Compare(TEXT("Test"), *MakeReport(11.2f, true), Results);
+	const FRunnerPerfMetricResult* P50 = FindResult(Results, TEXT("FrameTimeMs.P50"));
+	const FRunnerPerfMetricResult* P95 = FindResult(Results, TEXT("FrameTimeMs.P95"));
+	if (TestNotNull(TEXT("FrameTimeMs.P50 result"), P50) && TestNotNull(TEXT("FrameTimeMs.P95 result"), P95))
+	{
+		TestTrue(TEXT("12% over the P50 tolerance regressed"), P50->bRegressed);
+		TestFalse(TEXT("12% within the P95 tolerance regressed"), P95->bRegressed);
+		TestEqual(TEXT("P50 baseline"), P50->Baseline, 10.0);
+	}
+
+	// 20% over a 2 ms baseline is only 0.4 ms
+	Baselines.SetBaseline(TEXT("Small"), *MakeReport(2, true));
+	Baselines.Compare(TEXT("Small"), *MakeReport(2.4f, true), Results);
+	P50 = FindResult(Results, TEXT("FrameTimeMs.P50"));
+	if (TestNotNull(TEXT("FrameTimeMs.P50 result"), P50))
+	{
+		TestFalse(TEXT("Change below the absolute minimum regressed"), P50->bRegressed);
+	}
+
+	// A metric of the baseline missing from the run fails, one missing from the baseline is not gated
+	Baselines.Compare(TEXT("Test"), *MakeReport(10, false), Results);
+	const FRunnerPerfMetricResult* GameThread = FindResult(Results, TEXT("GameThreadMs.P95"));
+	const FRunnerPerfMetricResult* GCPause = FindResult(Results, TEXT("GCPauseMs.P95"));
+	if (TestNotNull(TEXT("GameThreadMs.P95 result"), GameThread) && TestNotNull(TEXT("GCPauseMs.P95 result"), GCPause))
+	{
+		TestTrue(TEXT("Metric missing from the run regressed"), GameThread->bMissing && GameThread->bRegressed);
+		TestTrue(TEXT("Metric missing from the baseline is skipped"), GCPause->bMissing && !GCPause->bRegressed);
+	}
+
+	AddExpectedError(TEXT("no baseline named"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Compare with an unknown baseline"), Baselines.Compare(TEXT("Unknown"), *MakeReport(10, true), Results));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerBenchmarkEmptyBaselineTest, "Runner.Benchmark.EmptyBaseline",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerBenchmarkEmptyBaselineTest::RunTest(const FString& Parameters)
+{
+	using namespace RunnerBenchmarkTests;
+
+	const FString MissingPath = FPaths::AutomationTransientDir() / TEXT("RunnerMissingBaselines.json");
+	FRunnerPerfBaselines Baselines;
+	AddExpectedError(TEXT("not found, record a baseline"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Load a missing file"), Baselines.Load(MissingPath));
+	TestTrue(TEXT("Load a missing file when recording"), Baselines.Load(MissingPath, true));
+
+	// A baseline without metrics must not pass every run
+	const FString EmptyPath = FPaths::AutomationTransientDir() / TEXT("RunnerEmptyBaselines.json");
+	if (!TestTrue(TEXT("Write the baseline file"), FFileHelper::SaveStringToFile(TEXT("{\"Version\":1,\"Baselines\":{\"Empty\":{\"Metrics\":{}}}}"), *EmptyPath)))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Load the baseline file"), Baselines.Load(EmptyPath));
+	TArray<FRunnerPerfMetricResult> Results;
+	AddExpectedError(TEXT("has no metrics to compare"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Compare with an empty baseline"), Baselines.Compare(TEXT("Empty"), *MakeReport(10, true), Results));
+	return true;
+}
+
+#endif
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSignificanceSubsystem.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RunnerSignificanceTests
+{
+	enum ETier { Near, Mid, Behind, Passed, Far };
+
+	/** Returns the tiers in the order of DefaultGame.ini, without budgets */
+	TArray<FRunnerSignificanceTier> MakeTiers()
+	{
+		auto MakeTier = [](const TCHAR* Name, float MinDistance, float MaxDistance)
+		{
+			FRunnerSignificanceTier Tier;
+			Tier.Name = Name;
+			Tier.MinDistance = MinDistance;
+			Tier.MaxDistance = MaxDistance;
+			return Tier;
+		};
+		return {
+			MakeTier(TEXT("Near"), -500, 4000),
+			MakeTier(TEXT("Mid"), -500, 12000),
+			MakeTier(TEXT("Behind"), -2000, -500),
+			MakeTier(TEXT("Passed"), -1000000, -2000),
+			MakeTier(TEXT("Far"), 12000, 1000000)
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerSignificanceTierBudgetsTest, "Runner.Significance.TierBudgets",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerSignificanceTierBudgetsTest::RunTest(const FString& Parameters)
+{
+	using namespace RunnerSignificanceTests;
+
+	TArray<FRunnerSignificanceTier> Tiers = MakeTiers();
+	TArray<int32> Scratch;
+	TArray<int32> Assigned;
+	TArray<int32> Counts;
+
+	// Without budgets every object gets the first tier containing its distance
+	URunnerSignificanceSubsystem::AssignTiers(Tiers, TArray<float>({ 100.0f, 8000.0f, -1000.0f, -5000.0f, 20000.0f }), Scratch, Assigned, Counts);
+	TestTrue(TEXT("Tiers by distance"), Assigned == TArray<int32>({ Near, Mid, Behind, Passed, Far }));
+	TestTrue(TEXT("Counts by distance"), Counts == TArray<int32>({ 1, 1, 1, 1, 1 }));
+
+	// The closest objects stay in a full tier, in any order of the input
+	Tiers[Near].MaxObjects = 2;
+	URunnerSignificanceSubsystem::AssignTiers(Tiers, TArray<float>({ 300.0f, 100.0f, 200.0f }), Scratch, Assigned, Counts);
+	TestTrue(TEXT("Farthest object over the Near budget"), Assigned == TArray<int32>({ Mid, Near, Near }));
+	TestTrue(TEXT("Counts with the Near budget"), Counts == TArray<int32>({ 2, 1, 0, 0, 0 }));
+
+	// Objects behind the player overflow to the tiers behind, not to Mid
+	Tiers[Near].MaxObjects = 1;
+	URunnerSignificanceSubsystem::AssignTiers(Tiers, TArray<float>({ -100.0f, -200.0f }), Scratch, Assigned, Counts);
+	TestTrue(TEXT("Object behind over the Near budget"), Assigned == TArray<int32>({ Near, Behind }));
+
+	// A full Mid tier moves objects ahead of the player to Far, never to Behind which has no collision
+	Tiers[Near].MaxObjects = 0;
+	Tiers[Mid].MaxObjects = 1;
+	URunnerSignificanceSubsystem::AssignTiers(Tiers, TArray<float>({ 6000.0f, 5000.0f }), Scratch, Assigned, Counts);
+	TestTrue(TEXT("Object ahead over the Mid budget"), Assigned == TArray<int32>({ Far, Mid }));
+	TestEqual(TEXT("Overflow tier ahead of Mid"), URunnerSignificanceSubsystem::FindOverflowTier(Tiers, Mid, 6000.0f), int32(Far));
+	TestEqual(TEXT("Overflow tier behind Mid"), URunnerSignificanceSubsystem::FindOverflowTier(Tiers, Mid, -100.0f), int32(Behind));
+
+	// A full tier without a farther tier keeps its objects over the budget
+	Tiers[Mid].MaxObjects = 0;
+	Tiers[Far].MaxObjects = 1;
+	URunnerSignificanceSubsystem::AssignTiers(Tiers, TArray<float>({ 20000.0f, 30000.0f }), Scratch, Assigned, Counts);
+	TestTrue(TEXT("Objects over the budget of the farthest tier"), Assigned == TArray<int32>({ Far, Far }));
+	TestEqual(TEXT("Far count over its budget"), Counts[Far], 2);
+	return true;
+}
+
+#endif
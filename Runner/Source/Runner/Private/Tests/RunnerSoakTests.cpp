@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerSoakSubsystem.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerSoakLeakClassifierTest, "Runner.Soak.LeakClassifier",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerSoakLeakClassifierTest::RunTest(const FString& Parameters)
+{
+	auto MakeSeries = [](int32 Count, TFunctionRef<double(int32)> GetValue)
+	{
+		TArray<double> Series;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Series.Add(GetValue(Index));
+		}
+		return Series;
+	};
+	double Growth = 0;
+
+	TestFalse(TEXT("Flat series"), URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32) { return 100.0; }), 20, 0, Growth));
+	TestEqual(TEXT("Flat series growth"), Growth, 0.0, 1e-9);
+
+	// 10 per sample over 9 steps
+	TestTrue(TEXT("Linear growth"), URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32 Index) { return 100.0 + 10 * Index; }), 20, 0, Growth));
+	TestEqual(TEXT("Linear growth from the fit"), Growth, 90.0, 1e-6);
+
+	TestFalse(TEXT("Growth below the absolute tolerance"),
+		URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32 Index) { return 100.0 + Index; }), 20, 0, Growth));
+	TestFalse(TEXT("Growth below the relative tolerance"),
+		URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32 Index) { return 10000.0 + 10 * Index; }), 20, 0.02, Growth));
+
+	// Most steps of a flat series with one spike do not decrease, the fit keeps the spike from counting as growth
+	TestFalse(TEXT("Single spike"), URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32 Index) { return Index == 4 ? 1000.0 : 100.0; }), 20, 0, Growth));
+
+	// Up 30, down 10: grows overall, but only half of the steps do not decrease
+	TestFalse(TEXT("Sawtooth below the non-decreasing share"),
+		URunnerSoakSubsystem::IsGrowing(MakeSeries(11, [](int32 Index) { return 100.0 + 10 * Index + (Index % 2) * 20; }), 20, 0, Growth));
+	TestTrue(TEXT("Sawtooth grows"), Growth > 20);
+
+	// Only 140 to 125 decreases, 8 of 9 steps do not, which is above 80%
+	TestTrue(TEXT("One decreasing step"),
+		URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32 Index) { return Index == 5 ? 125.0 : 100.0 + 10 * Index; }), 20, 0, Growth));
+
+	// 7 of 9 steps do not decrease, which is below 80%
+	TestFalse(TEXT("Two decreasing steps"),
+		URunnerSoakSubsystem::IsGrowing(MakeSeries(10, [](int32 Index) { return Index == 3 || Index == 6 ? 100.0 + 10 * Index - 15 : 100.0 + 10 * Index; }), 20, 0, Growth));
+
+	TestFalse(TEXT("Too few samples"), URunnerSoakSubsystem::IsGrowing({ 0, 1000 }, 20, 0, Growth));
+	return true;
+}
+
+#endif
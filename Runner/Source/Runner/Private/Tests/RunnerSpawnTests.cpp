@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RunnerGenericStruct.h"
+#include "RunnerSpawnAllocCommandlet.h"
+#include "RunnerSpawnLayout.h"
+#include "RunnerSpawnPolicies.h"
+#include "RunnerSpawnPolicyBenchCommandlet.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Lays out 100 tiles without creating their actors, spawning the child actors allocates and is not covered */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerSpawnLayoutIsAllocationFreeTest, "Runner.Spawn.LayoutIsAllocationFree",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerSpawnLayoutIsAllocationFreeTest::RunTest(const FString& Parameters)
+{
+	// Three lanes of six points are laid out by a spawn policy
+	FSpawnSettings PolicySettings;
+	PolicySettings.ActorClasses = { AActor::StaticClass() };
+	PolicySettings.LaneYOffsets = { -325, 0, 325 };
+	PolicySettings.PointsPerLane = 6;
+	PolicySettings.ActorNum = 6;
+
+	// No policy has five lanes, so these go through the generic layout on the memory stack
+	FSpawnSettings GenericSettings = PolicySettings;
+	GenericSettings.LaneYOffsets = { -400, -200, 0, 200, 400 };
+	GenericSettings.PointsPerLane = 5;
+	GenericSettings.ActorNum = 10;
+	GenericSettings.bRandomRotator = true;
+
+	const FSpawnSettings* Spawners[] = { &PolicySettings, &GenericSettings };
+	const RunnerSpawnAlloc::FLayoutAllocations Result = RunnerSpawnAlloc::CountLayoutAllocations(Spawners, FVector(500, 500, 0), 100, 10);
+
+	TestEqual(TEXT("Objects laid out"), Result.Objects, 100 * (PolicySettings.ActorNum + GenericSettings.ActorNum));
+	TestEqual(TEXT("Tiles whose layout allocated"), Result.FailedTiles, 0);
+	TestEqual(TEXT("Layout allocations"), Result.Allocations, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunnerSpawnPoliciesMatchGenericLayoutTest, "Runner.Spawn.PoliciesMatchGenericLayout",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRunnerSpawnPoliciesMatchGenericLayoutTest::RunTest(const FString& Parameters)
+{
+	struct FSpawnRecord
+	{
+		UClass* ActorClass;
+		FTransform Transform;
+	};
+
+	constexpr int32 Layouts = 1000;
+	const FVector FloorExtent(500, 0, 0);
+	TArray<FSpawnRecord> Generic;
+	TArray<FSpawnRecord> Specialized;
+	for (const RunnerSpawnPolicyBench::FBenchCase& Case : RunnerSpawnPolicyBench::MakeCases())
+	{
+		if (!TestTrue(FString::Printf(TEXT("%s settings match their policy"), Case.Name), Case.Matches(Case.Settings)))
+		{
+			continue;
+		}
+
+		// Stop at the first differing layout of a case, the rest would repeat the error
+		for (int32 Layout = 0; Layout < Layouts; ++Layout)
+		{
+			Generic.Reset();
+			Specialized.Reset();
+			RunnerSpawnLayout::LayOutObjects(Case.Settings, FloorExtent, FRandomStream(Layout), [&Generic](UClass* ActorClass, const FTransform& SpawnTransform)
+			{
+				Generic.Add({ ActorClass, SpawnTransform });
+			});
+			RunnerSpawnPolicies::TryLayOutObjects(Case.Settings, FloorExtent, FRandomStream(Layout), [&Specialized](UClass* ActorClass, const FTransform& SpawnTransform)
+			{
+				Specialized.Add({ ActorClass, SpawnTransform });
+			});
+
+			bool bSame = Generic.Num() == Specialized.Num();
+			for (int32 i = 0; bSame && i < Generic.Num(); ++i)
+			{
+				bSame = Generic[i].ActorClass == Specialized[i].ActorClass && Generic[i].Transform.Equals(Specialized[i].Transform);
+			}
+			if (!bSame)
+			{
+				AddError(FString::Printf(TEXT("%s seed %d lays out %d objects that differ from the %d of the generic layout"),
+					Case.Name, Layout, Specialized.Num(), Generic.Num()));
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+#endif
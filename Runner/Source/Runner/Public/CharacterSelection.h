@@ -6,8 +6,10 @@
 #include "GameFramework/Actor.h"
 #include "CharacterSelection.generated.h"
 
+class ACharacter;
 class ARunnerCharacter;
 class URunnerGameInstance;
+struct FStreamableHandle;
 
 UCLASS()
 class RUNNER_API ACharacterSelection : public AActor
@@ -22,6 +24,9 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the actor is removed from the level
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 /*
  * Default Scene Components
  */
@@ -36,12 +41,13 @@ public:
  * Character Selection
  */
 public:
+	// Array of Character Pawns, only the shown character and its neighbors are loaded
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default|Character Selection")
-	TArray<UClass*> CharacterPawnArray;
+	TArray<TSoftClassPtr<ACharacter>> CharacterPawnArray;
 
-	// Array of Skeletal Meshes
+	// Array of Skeletal Meshes, only the shown character and its neighbors are loaded
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default|Character Selection")
-	TArray<USkeletalMesh*> CharacterMeshArray;
+	TArray<TSoftObjectPtr<USkeletalMesh>> CharacterMeshArray;
 
 	UFUNCTION(BlueprintCallable)
 	void PrevCharacter();
@@ -57,4 +63,25 @@ protected:
 
 	UPROPERTY()
 	TObjectPtr<URunnerGameInstance> MyGameInstance;
+
+	/** Save the character once it is shown, used for the default character */
+	bool bSaveWhenShown = false;
+
+	/** Streaming handles of loaded characters keyed by array index */
+	TMap<int32, TSharedPtr<FStreamableHandle>> CharacterHandles;
+
+	/** Stream in the current character and its neighbors, release the others */
+	void UpdateCharacterStreaming();
+
+	/** Request the mesh and pawn class of the given character */
+	void RequestCharacter(int32 Index);
+
+	/** Show the current character if its mesh is loaded, otherwise it is shown once streaming completes */
+	void ShowCurrentCharacter();
+
+	/** Streaming callback for the given character */
+	void OnCharacterLoaded(int32 Index);
+
+	/** Wrap the index around the character array */
+	int32 WrapIndex(int32 Index) const;
 };
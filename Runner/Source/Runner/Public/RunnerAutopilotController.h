@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerAutopilotPlanner.h"
+#include "RunnerPlayerController.h"
+#include "RunnerAutopilotController.generated.h"
+
+class ARunnerCharacter;
+class ARunnerGameMode;
+
+/**
+ *  Player controller that plays runs by itself for soak tests and benchmarks.
+ *  Reads the objects on the floor tiles ahead, plans with the same rules as the batch simulator
+ *  and issues the commands through the same paths as the player input. Resumes after every death.
+ *
+ *  Enabled with -Autopilot or ?Autopilot, optionally with -AutopilotSkill=, -AutopilotSeed= and -AutopilotDuration=<seconds>.
+ */
+UCLASS()
+class RUNNER_API ARunnerAutopilotController : public ARunnerPlayerController
+{
+	GENERATED_BODY()
+
+public:
+	ARunnerAutopilotController();
+
+	virtual void BeginPlay() override;
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** Settings of the planner */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot")
+	FRunnerAutopilotSettings Settings;
+
+	/** Use a fixed seed for the planner and the tile layouts, so the same build plays the same runs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot")
+	bool bDeterministic = false;
+
+	/** Seed used in deterministic mode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (EditCondition = "bDeterministic"))
+	int32 Seed = 1;
+
+	/** Time between death and resume in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (ClampMin = "0"))
+	float ResumeDelay = 2;
+
+	/** Quit after this many seconds, 0 plays until stopped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (ClampMin = "0"))
+	float SessionDuration = 0;
+
+	/** Apply the command line options to the settings */
+	void ApplyCommandLine(const TCHAR* CommandLine);
+
+protected:
+	/** Pointer to game mode */
+	TObjectPtr<ARunnerGameMode> MyGameMode;
+
+	/** Random stream of the planner decisions */
+	FRandomStream RandomStream;
+
+	/** Objects on the tiles ahead, rebuilt every tick */
+	TArray<FRunnerTrackObject> TrackObjects;
+
+	/** Time since the player died */
+	float DeadTime = 0;
+
+	/** Time since the session started */
+	double SessionTime = 0;
+
+	int32 RunCount = 0;
+
+	/** Track position where the current run started */
+	double RunStartPosition = 0;
+
+	/** Collect the objects in front of the player from the floor tiles */
+	void GatherTrackObjects(const ARunnerCharacter& MyCharacter);
+
+	/** Issue the planned commands through the player input paths */
+	void ApplyInput(ARunnerCharacter& MyCharacter, const FRunnerSimInput& Input);
+
+	/** Log the finished run and resume */
+	void HandleDeath(ARunnerCharacter& MyCharacter, float DeltaSeconds);
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerSimulation.h"
+#include "Math/RandomStream.h"
+#include "RunnerAutopilotPlanner.generated.h"
+
+/** Kind of an object on the track */
+enum class ERunnerTrackObjectKind : uint8
+{
+	Coin,
+	Powerup,
+	Obstacle
+};
+
+/**
+ *  Object in front of the player, in simulation track coordinates
+ */
+struct FRunnerTrackObject
+{
+	/** Position along the track */
+	double X = 0;
+
+	/** Speed towards the player */
+	float Speed = 0;
+
+	int32 Lane = 0;
+
+	/** Index of the spawner that placed the object */
+	int32 SpawnerIndex = 0;
+
+	ERunnerTrackObjectKind Kind = ERunnerTrackObjectKind::Coin;
+
+	/** False if the player overlooks the object */
+	bool bNoticed = true;
+};
+
+/**
+ *  Settings of the autopilot player
+ */
+USTRUCT(BlueprintType)
+struct FRunnerAutopilotSettings
+{
+	GENERATED_BODY()
+
+	/** Chance to notice an obstacle, 1 never misses one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (ClampMin = "0", ClampMax = "1"))
+	float Skill = 0.9f;
+
+	/** Obstacles closer than this time to contact are avoided */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (ClampMin = "0"))
+	float LookaheadTime = 0.8f;
+
+	/** Time to contact at which the player jumps or slides when no lane is free */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (ClampMin = "0"))
+	float JumpLeadTime = 0.15f;
+
+	/** Chance per decision at full skill to steer towards a lane with more coins */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Autopilot", meta = (ClampMin = "0", ClampMax = "1"))
+	float CoinSeekChance = 0.05f;
+};
+
+/**
+ *  Decision rules of the autopilot player.
+ *  Shared by the autopilot controller in the world and by tools simulating runs without a world.
+ */
+namespace RunnerAutopilot
+{
+	/** Returns the index of the lane closest to the given Y-axis position */
+	RUNNER_API int32 FindNearestLane(const TArray<float>& LaneYOffsets, float Y);
+
+	/** Returns the lane the player body is in, it leaves the old lane halfway through a switch */
+	RUNNER_API int32 GetOccupiedLane(const FRunnerSimState& State);
+
+	/** Returns true if the stable key of an object falls within the skill, the same object is always noticed or overlooked */
+	RUNNER_API bool IsNoticed(uint32 ObjectKey, int32 Seed, float Skill);
+
+	/** Returns true if an obstacle is in the lane between the two track positions */
+	RUNNER_API bool IsLaneBlocked(const TArray<FRunnerTrackObject>& Objects, int32 Lane, double FromX, double ToX);
+
+	/** Plans the commands of the next step, dodges the obstacles it noticed and steers towards coins */
+	RUNNER_API FRunnerSimInput PlanInput(const FRunnerAutopilotSettings& Settings, const FRunnerSimConfig& Config, const FRunnerSimState& State,
+		const TArray<FRunnerTrackObject>& Objects, const FRandomStream& RandomStream);
+}
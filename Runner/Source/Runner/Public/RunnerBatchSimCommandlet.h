@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RunnerBatchSimCommandlet.generated.h"
+
+/**
+ *  Simulates runs in parallel without a world to balance the floor spawner settings.
+ *  Tiles are laid out with the same rules as the spawn components and played by a heuristic player,
+ *  the distributions of distance, coins and death causes are written per configuration.
+ *
+ *  Usage: -run=RunnerBatchSim [-Runs=2000] [-Seed=1] [-MaxTiles=2000] [-Skill=0.9] [-TileClass=<class path>]
+ *         [-TileLength=<cm>] [-MovingObstacleSpeed=300] [-Sweep=Obstacle.ActorNum:1,2,3;Coin.ActorNum:5,10] [-Output=<csv path>]
+ */
+UCLASS()
+class RUNNER_API URunnerBatchSimCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URunnerBatchSimCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerBenchmarkSubsystem.generated.h"
+
+class FJsonObject;
+
+/** State of a benchmark run after a frame */
+enum class ERunnerBenchmarkResult : uint8
+{
+	Running,
+	Succeeded,
+	TimedOut
+};
+
+/**
+ *  Records a benchmark of an autopilot run and writes a JSON report, then quits with a non-zero exit code on failure.
+ *  Created only when the game is started with -RunnerBenchmark, which also enables the autopilot with a fixed seed.
+ *
+ *  Usage: Runner.uproject /Game/Runner/Maps/RunnerMap_L1 -game -nullrhi -unattended -RunnerBenchmark
+ *         [-AutopilotSeed=1] [-BenchmarkDistance=200000] [-BenchmarkTimeout=900] [-BenchmarkReport=<json path>]
+ *         [-BenchmarkBaseline=<name>] to also fail on regressions against a stored baseline
+ */
+UCLASS()
+class RUNNER_API URunnerBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Returns whether a run that covered the distance in the elapsed real time succeeded, timed out or goes on */
+	static ERunnerBenchmarkResult GetResult(double Distance, double ElapsedSeconds, double TargetDistance, double TimeoutSeconds);
+
+	/** Returns count, mean, p50, p95, p99 and max of the samples */
+	static TSharedRef<FJsonObject> MakeDistribution(TArray<float> Samples);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Distance along the track to run */
+	double TargetDistance = 200000;
+
+	/** Real time after which the benchmark fails */
+	double TimeoutSeconds = 900;
+
+	FString ReportPath;
+
+	bool bStarted = false;
+
+	bool bFinished = false;
+
+	double StartTime = 0;
+
+	double StartPosition = 0;
+
+	int32 StartTileIndex = 0;
+
+	int32 NextMilestoneTile = 100;
+
+	int32 Deaths = 0;
+
+	bool bWasDead = false;
+
+	TArray<float> FrameTimes;
+
+	TArray<float> GameThreadTimes;
+
+	TArray<float> GCPauses;
+
+	double GCStartTime = 0;
+
+	FDelegateHandle PreGCHandle;
+
+	FDelegateHandle PostGCHandle;
+
+	int32 PeakActors = 0;
+
+	int32 PeakComponents = 0;
+
+	uint64 PeakUsedPhysical = 0;
+
+	uint64 PeakUsedVirtual = 0;
+
+	/** Peak bytes of each runner LLM tag, in the order of RunnerLLM::GetAllTags, empty without -llm */
+	TArray<int64> PeakTagMemory;
+
+	/** Bytes of each runner LLM tag sampled every 100 tiles, one row of RunnerLLM::GetAllTags per sample */
+	TArray<int64> TagMemoryAtTile;
+
+	/** Tile, actor count and component count sampled every 100 tiles */
+	TArray<FIntVector> CountsAtTile;
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+
+	/** Count live actors and components and update the peaks */
+	void SampleObjectCounts(int32& OutActors, int32& OutComponents);
+
+	void SampleMemory();
+
+	/** Write the report and quit */
+	void Finish(bool bSucceeded, const FString& Reason, double Distance, int32 Tiles);
+};
@@ -4,7 +4,6 @@
 
 #include "CoreMinimal.h"
 #include "RunnerGenericStruct.h"
-#include "Components/TimelineComponent.h"
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
 #include "RunnerCharacter.generated.h"
@@ -15,6 +14,8 @@ class USaveGame;
 class ARunnerPlayerController;
 class USpringArmComponent;
 class UCameraComponent;
+class URunnerSimulationComponent;
+class UCurveFloat;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
@@ -59,6 +60,34 @@ public:
 	
 	/** Returns FollowCamera subobject */
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+
+/**
+ *  -----------------------------------
+ *  Gameplay Simulation
+ *  -----------------------------------
+ */
+public:
+	/**
+	 * Fixed-timestep simulation owning track position, speed, passed tiles, lane and effect timers.
+	 * Speed and tile score only depend on the simulated track position. The movement component moves the actor at
+	 * the simulated speed and still resolves jumps and collisions, so where a collision happens is not simulated.
+	 */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Default|Simulation")
+	TObjectPtr<URunnerSimulationComponent> Simulation;
+
+	/** Returns Simulation subobject */
+	FORCEINLINE URunnerSimulationComponent* GetSimulation() const { return Simulation; }
+
+protected:
+	/** Copy movement settings into the simulation and reset it */
+	void InitSimulation();
+
+	/** Advance the simulation and apply its state to the character */
+	void TickSimulation(float DeltaTime);
+
+	/** Score added for each tile passed in the simulation, read from the floor tile class */
+	int32 TileScoreIncrement = 1;
+
 /**
  *  -----------------------------------
  *  Player Movement - Slide
@@ -77,10 +106,7 @@ public:
 	void StartSlide();
 
 protected:
-	/** Timer handle for the sliding animation */
-	FTimerHandle SlidingTimerHandle;
-	
-	/** Timer call back function to handle settings when sliding finished */
+	/** Called when the simulation finished the slide */
 	void EndSlide();
 
 /**
@@ -113,21 +139,7 @@ public:
 	void SwitchLane(int32 LaneOffset);
 
 protected:
-	/** Struct to manage data required for lane switch */
-	FLaneSwitchData LaneSwitchData;
-	
-	/** Timeline for lane switch */
-	FTimeline LaneSwitchTimeline;
-
-	/** Initialize timelinefor lane switch */
-	void InitTimelineForLaneSwitch();
-	
-	/** Timeline progress for lane switch */
-	UFUNCTION()
-	void OnLaneSwitchProgress(float Value);
-
-	/** Event to handle when the lane switch timeline finishes */
-	UFUNCTION()
+	/** Called when the simulation finished the lane switch */
 	void OnLaneSwitchFinished();
 	
 /**
@@ -200,12 +212,11 @@ public:
 	void ShowResumePopup();
 
 private:
-	/** Variable to store pause menu widget instance */
-	UPROPERTY()
-	TObjectPtr<UUserWidget> PauseMenuWidgetInstance = nullptr;
+	/** Show the cached instance of the given widget class on the given layer, reconstructing it if it was hidden when asked */
+	UUserWidget* AddWidgetToViewPort(const TSubclassOf<UUserWidget>& InWidgetClass, bool bShowMouseCursor, int32 Layer = 0, bool bReconstruct = false) const;
 
-	/** Add give widget class to the viewport */
-	void AddWidgetToViewPort(const TSubclassOf<UUserWidget>& InWidgetClass, bool bShowMouseCursor) const;
+	/** Hide the cached instance of the given widget class */
+	void RemoveWidgetFromViewPort(const TSubclassOf<UUserWidget>& InWidgetClass) const;
 
 /**
  *  -----------------------------------
@@ -238,12 +249,6 @@ public:
 	void MagnetPowerupStart();
 	
 protected:
-	/** Timer handler for the magnet active duration */
-	FTimerHandle TimerHandle_Magnet;
-
-	/** Update magnet timer variable based on given delta time*/
-	void UpdateMagnetTimer(float DeltaTime);
-
 	/** Reset variables when magnet power up effect end */
 	void MagnetPowerupEnd();
 };
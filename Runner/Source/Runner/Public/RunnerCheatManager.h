@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CheatManager.h"
+#include "RunnerCheatManager.generated.h"
+
+class URunnerStressSubsystem;
+
+/**
+ *  Cheats for Runner project, entered in the console after EnableCheats in builds that allow cheats
+ */
+UCLASS()
+class RUNNER_API URunnerCheatManager : public UCheatManager
+{
+	GENERATED_BODY()
+
+public:
+	/** Multiply ActorNum of all floor spawners on new tiles */
+	UFUNCTION(Exec)
+	void RunnerStressDensity(float Multiplier);
+
+	/** Multiply the lane count of all floor spawners on new tiles */
+	UFUNCTION(Exec)
+	void RunnerStressLanes(int32 Multiplier);
+
+	/** Force the player speed, 0 restores the tile settings */
+	UFUNCTION(Exec)
+	void RunnerStressMaxSpeed(float Speed);
+
+	/** Set the number of floor tiles kept ahead of the player */
+	UFUNCTION(Exec)
+	void RunnerStressTilesAhead(int32 Tiles);
+
+	/** Generate the given number of floor tiles now and move the player forward */
+	UFUNCTION(Exec)
+	void RunnerStressFastForward(int32 Tiles);
+
+	/** Increase the density until the p95 frame time crosses the budget and log the breaking point */
+	UFUNCTION(Exec)
+	void RunnerStressRamp(float BudgetMs = 16.6f);
+
+	/** Stop the ramp and restore all stress settings */
+	UFUNCTION(Exec)
+	void RunnerStressReset();
+
+private:
+	URunnerStressSubsystem* GetStressSubsystem() const;
+};
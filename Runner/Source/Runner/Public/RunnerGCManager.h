@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "RunnerGCManager.generated.h"
+
+/**
+ *  State of the run as seen by the garbage collection policy
+ */
+UENUM(BlueprintType)
+enum class ERunnerRunState : uint8
+{
+	Loading,
+	Running,
+	Dead,
+	Paused,
+	Num UMETA(Hidden)
+};
+
+/**
+ *  Garbage collection pauses during one run state
+ */
+struct FRunnerGCStateStats
+{
+	int32 Count = 0;
+
+	double TotalMs = 0;
+
+	double MaxMs = 0;
+};
+
+/**
+ *  Schedules garbage collection around the run.
+ *  Collections are deferred while running and a full purge is forced at the safe points:
+ *  the pause after death, the pause menu and the loading screen.
+ *  Incremental reachability is left off, the GC pause metrics time each collection between its delegates
+ *  and would report the time across all frames of an incremental collection instead of its pauses.
+ */
+UCLASS()
+class RUNNER_API URunnerGCManager : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	URunnerGCManager();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	/** Defer collections while the runner is running */
+	UPROPERTY(EditDefaultsOnly, Category = "Garbage Collection")
+	bool bDeferWhileRunning = true;
+
+	/** Longest time a collection is deferred while running, in seconds */
+	UPROPERTY(EditDefaultsOnly, Category = "Garbage Collection", meta = (ClampMin = "0", EditCondition = "bDeferWhileRunning"))
+	float MaxDeferSeconds = 120.0f;
+
+	/** Shortest time between forced collections at safe points, in seconds */
+	UPROPERTY(EditDefaultsOnly, Category = "Garbage Collection", meta = (ClampMin = "0"))
+	float MinSafePointInterval = 5.0f;
+
+	UFUNCTION(BlueprintCallable)
+	ERunnerRunState GetRunState() const { return RunState; }
+
+	/** Returns the pauses measured in a run state */
+	const FRunnerGCStateStats& GetStateStats(ERunnerRunState State) const { return StateStats[static_cast<int32>(State)]; }
+
+	/** Log the pauses of every run state */
+	void LogStateStats() const;
+
+private:
+	ERunnerRunState RunState = ERunnerRunState::Loading;
+
+	/** Run state when the current collection started */
+	ERunnerRunState CollectingState = ERunnerRunState::Loading;
+
+	FRunnerGCStateStats StateStats[static_cast<int32>(ERunnerRunState::Num)];
+
+	/** A collection was forced since the last safe point was entered */
+	bool bCollectedAtSafePoint = false;
+
+	double GCStartTime = 0;
+
+	double LastGCTime = 0;
+
+	FDelegateHandle PreGCHandle;
+
+	FDelegateHandle PostGCHandle;
+
+	ERunnerRunState ComputeRunState();
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+};
@@ -8,6 +8,9 @@
 
 class URunnerTileManager;
 class URunnerScoreManager;
+class URunnerWidgetManager;
+class URunnerGCManager;
+class ARunnerAutopilotController;
 
 /**
  *  Game mode for Runner project
@@ -20,8 +23,12 @@ class ARunnerGameMode : public AGameModeBase
 public:
 	ARunnerGameMode();
 
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
 private:
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 public:
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
@@ -32,6 +39,27 @@ public:
 
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	TObjectPtr<URunnerScoreManager> RunnerScoreManager;
+
+	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
+	TObjectPtr<URunnerWidgetManager> RunnerWidgetManager;
+
+	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
+	TObjectPtr<URunnerGCManager> RunnerGCManager;
+
+	/** Player controller used when the game is started with -Autopilot or ?Autopilot */
+	UPROPERTY(EditDefaultsOnly, Category = "Autopilot")
+	TSubclassOf<ARunnerAutopilotController> AutopilotControllerClass;
+
+/**
+ *  Loading Screen Warm-up
+ */
+protected:
+	/** Register tasks that run while the loading screen is displayed */
+	virtual void RegisterWarmupTasks();
+
+private:
+	/** Resume the game once the loading screen is released */
+	void OnWarmupFinished();
 };
 
 
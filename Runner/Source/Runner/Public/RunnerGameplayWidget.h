@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "RunnerGameplayWidget.generated.h"
+
+class UInvalidationBox;
+class UTextBlock;
+class URunnerScoreManager;
+
+/**
+ *  Base class of the gameplay HUD.
+ *  Texts are updated from the score manager change events instead of property bindings,
+ *  so the HUD placed under an invalidation box only repaints when a value changes.
+ *  Paint and prepass cost can be compared with "stat slate" or a "-trace=slate" Insights capture,
+ *  the number of HUD repaints is logged when the widget is destroyed.
+ */
+UCLASS()
+class RUNNER_API URunnerGameplayWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeConstruct() override;
+
+	virtual void NativeDestruct() override;
+
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+/**
+ *  Widgets bound from the Blueprint layout
+ */
+protected:
+	/** Invalidation box wrapping the HUD, caching is enforced on construct */
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	TObjectPtr<UInvalidationBox> HUDInvalidationBox;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> ScoreText;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> CoinsText;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> HighScoreText;
+
+/**
+ *  Score Events
+ */
+protected:
+	/** Called after the score text changed */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Score")
+	void OnScoreUpdated(int32 NewScore, int32 Delta);
+
+	/** Called after the coins text changed */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Score")
+	void OnCoinsUpdated(int32 NewCoins, int32 Delta);
+
+	/** Called after the high score text changed */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Score")
+	void OnHighScoreUpdated(int32 NewHighScore, int32 Delta);
+
+private:
+	UPROPERTY()
+	TObjectPtr<URunnerScoreManager> ScoreManager;
+
+	/** Number of frames the HUD content was repainted since construct, every frame without an invalidation box */
+	mutable int32 PaintCount = 0;
+
+	/** Number of value updates since construct */
+	int32 UpdateCount = 0;
+
+	/** Time the widget was constructed */
+	double ConstructTime = 0.0;
+
+	UFUNCTION()
+	void HandleScoreChanged(int32 NewValue, int32 Delta);
+
+	UFUNCTION()
+	void HandleCoinsChanged(int32 NewValue, int32 Delta);
+
+	UFUNCTION()
+	void HandleHighScoreChanged(int32 NewValue, int32 Delta);
+};
@@ -6,6 +6,20 @@
 #include "UObject/ObjectMacros.h"
 #include "RunnerGenericStruct.generated.h"
 
+/**
+ *  Kind of objects a spawner places, used to attribute stats
+ */
+UENUM(BlueprintType)
+enum class ERunnerSpawnerType : uint8
+{
+	Other,
+	Coin,
+	Powerup,
+	Obstacle,
+	MovingObstacle,
+	Scenery
+};
+
 /**
  *  Settings to configure how the objects should be placed
  */
@@ -76,30 +90,6 @@ struct FSpawnSettings
 	int SpawnIntervalRandomOffset;
 };
 
-/**
- * Data for handling lane switch locations
- */
-USTRUCT()
-struct FLaneSwitchData
-{
-	GENERATED_BODY()
-
-	/** Start location of the lane switch */
-	FVector StartLocation;
-
-	/** Target location of the lane switch */
-	FVector EndLocation;
-
-	/** Target lane index */
-	int32 NewLaneIndex;
-
-	/** Constructor for initialization */
-	FLaneSwitchData(): NewLaneIndex(0) {}
-
-	FLaneSwitchData(const FVector& Start, const FVector& End, const int32 LaneIndex)
-		: StartLocation(Start), EndLocation(End), NewLaneIndex(LaneIndex) {}
-};
-
 /**
  *  Generic Struct
  */
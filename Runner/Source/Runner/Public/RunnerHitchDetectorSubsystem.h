@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerHitchDetectorSubsystem.generated.h"
+
+/**
+ *  Flags frames over a budget and appends a record of the runner scopes that ran in the frame to Saved/Logs/RunnerHitches.log.
+ *  Created only when the game is started with -RunnerHitches.
+ *
+ *  Usage: -RunnerHitches [-HitchBudgetMs=33.3] [-HitchSnapshot] to also write an Insights snapshot around each hitch,
+ *         which needs tracing enabled, e.g. -trace=cpu,runner
+ */
+UCLASS()
+class RUNNER_API URunnerHitchDetectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	float BudgetMs = 33.3f;
+
+	FString LogPath;
+
+	/** Time of the previous tick, frames are measured between ticks so they match the counter deltas */
+	double LastTickTime = 0;
+
+	/** Cost counter totals at the previous tick */
+	TArray<int32> LastCallCounts;
+
+	TArray<double> LastTotalSeconds;
+
+	double GCStartTime = 0;
+
+	/** GC time since the previous tick */
+	double FrameGCSeconds = 0;
+
+	FDelegateHandle PreGCHandle;
+
+	FDelegateHandle PostGCHandle;
+
+	/** Records not yet appended to the log */
+	TArray<FString> PendingRecords;
+
+	double LastFlushTime = 0;
+
+	int32 HitchCount = 0;
+
+	/** Insights snapshots */
+	bool bWriteSnapshots = false;
+
+	/** Time to write the pending snapshot, 0 when none is pending */
+	double SnapshotTime = 0;
+
+	double LastSnapshotTime = 0;
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+
+	/** Remember the counter totals as the start of the next frame */
+	void ResetFrame();
+
+	void RecordHitch(double FrameSeconds);
+
+	/** Append the pending records to the log */
+	void Flush();
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ *  Result of comparing one benchmark metric with its baseline
+ */
+struct FRunnerPerfMetricResult
+{
+	FString Name;
+
+	/** Runner subsystem the metric is attributed to */
+	FString Subsystem;
+
+	double Baseline = 0;
+
+	double Value = 0;
+
+	/** Allowed relative increase */
+	double Tolerance = 0;
+
+	/** False for metrics that cover the whole frame rather than one subsystem */
+	bool bAttributable = true;
+
+	bool bMissing = false;
+
+	bool bRegressed = false;
+
+	/** Returns the relative change from the baseline */
+	double GetChange() const { return Baseline > 0 ? Value / Baseline - 1 : 0; }
+};
+
+/**
+ *  Named baselines of benchmark metrics, stored in a versioned JSON file in the project.
+ *  Benchmark reports are compared against a baseline and fail when a metric regresses past its tolerance.
+ */
+class RUNNER_API FRunnerPerfBaselines
+{
+public:
+	FRunnerPerfBaselines();
+
+	/** Returns the baseline file in the project */
+	static FString GetDefaultPath();
+
+	/** Load the baseline file, a missing file fails unless allowed, e.g. when recording the first baseline */
+	bool Load(const FString& Path, bool bAllowMissing = false);
+
+	bool Save(const FString& Path) const;
+
+	/** Store the metrics of a benchmark report as the named baseline */
+	void SetBaseline(const FString& Name, const FJsonObject& Report);
+
+	/** Compare a benchmark report with the named baseline, returns false if there is no such baseline or it gates no metric */
+	bool Compare(const FString& Name, const FJsonObject& Report, TArray<FRunnerPerfMetricResult>& OutResults) const;
+
+	/** Log the results and the subsystem most likely responsible, returns true if nothing regressed */
+	static bool LogResults(const FString& Name, const TArray<FRunnerPerfMetricResult>& Results);
+
+	/** Load a benchmark report written by URunnerBenchmarkSubsystem */
+	static TSharedPtr<FJsonObject> LoadReport(const FString& Path);
+
+private:
+	TSharedRef<FJsonObject> Root;
+};
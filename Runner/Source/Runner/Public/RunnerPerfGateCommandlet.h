@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RunnerPerfGateCommandlet.generated.h"
+
+/**
+ *  Compares a benchmark report with a named baseline and fails on regressions, or stores the report as the baseline.
+ *  Baselines live in Build/PerfBaselines/RunnerPerfBaselines.json and are submitted with the change that moves them.
+ *  A missing file or a baseline without metrics fails the gate, record one with -Update first.
+ *
+ *  Usage: -run=RunnerPerfGate -Report=<json path> [-Baseline=<name, defaults to the report map>] [-Update] [-Baselines=<json path>]
+ */
+UCLASS()
+class RUNNER_API URunnerPerfGateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URunnerPerfGateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerPerfOverlaySubsystem.generated.h"
+
+struct FRunnerPerfOverlayData;
+class SWidget;
+
+/**
+ *  Shows live runner metrics in a Slate overlay on the game viewport, not available in shipping builds.
+ *  Toggled with the Runner.PerfOverlay console command, -RunnerPerfOverlay shows it from the start.
+ */
+UCLASS()
+class RUNNER_API URunnerPerfOverlaySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	URunnerPerfOverlaySubsystem();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void SetVisible(bool bInVisible);
+
+	bool IsVisible() const { return bVisible; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TSharedRef<FRunnerPerfOverlayData> Data;
+
+	/** Overlay added to the game viewport */
+	TSharedPtr<SWidget> Widget;
+
+	bool bVisible = false;
+
+	/** Time until the text lines are rebuilt */
+	float RefreshTimer = 0;
+
+	/** SpawnObjects counter totals of the previous frame */
+	int32 LastSpawnCalls = 0;
+
+	double LastSpawnSeconds = 0;
+
+	/** Highest SpawnObjects time of a single frame since the last refresh */
+	double PeakSpawnSeconds = 0;
+
+	int32 PeakSpawnCalls = 0;
+
+	double GCStartTime = 0;
+
+	double LastGCPauseSeconds = 0;
+
+	double LastGCTime = 0;
+
+	FDelegateHandle PreGCHandle;
+
+	FDelegateHandle PostGCHandle;
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+
+	/** Rebuild the text lines */
+	void RefreshLines();
+};
@@ -19,6 +19,8 @@ class RUNNER_API ARunnerPlayerController : public APlayerController
 	GENERATED_BODY()
 
 public:
+	ARunnerPlayerController();
+
 	virtual void BeginPlay() override;
 
 protected:
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerGenericStruct.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+DECLARE_STATS_GROUP(TEXT("Runner"), STATGROUP_Runner, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Spawned Coins"), STAT_RunnerSpawnedCoins, STATGROUP_Runner, RUNNER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Spawned Powerups"), STAT_RunnerSpawnedPowerups, STATGROUP_Runner, RUNNER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Spawned Obstacles"), STAT_RunnerSpawnedObstacles, STATGROUP_Runner, RUNNER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Spawned Moving Obstacles"), STAT_RunnerSpawnedMovingObstacles, STATGROUP_Runner, RUNNER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Spawned Scenery"), STAT_RunnerSpawnedScenery, STATGROUP_Runner, RUNNER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Spawned Other"), STAT_RunnerSpawnedOther, STATGROUP_Runner, RUNNER_API);
+
+/** Trace channel of the runner events, enabled with -trace=cpu,runner */
+UE_TRACE_CHANNEL_EXTERN(RunnerChannel, RUNNER_API);
+
+/** Count the rest of the scope in a STATGROUP_Runner cycle stat and emit it as an Insights event on the runner channel */
+#define RUNNER_SCOPE_CYCLE(StatName) \
+	SCOPE_CYCLE_COUNTER(StatName); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(StatName, RunnerChannel)
+
+/** Low-Level Memory Tracker tags of the runner subsystems, shown under Runner when run with -llm */
+LLM_DECLARE_TAG_API(Runner, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Tiles, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Skyline, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Spawned_Coins, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Spawned_Powerups, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Spawned_Obstacles, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Spawned_MovingObstacles, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Spawned_Scenery, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_Spawned_Other, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_UI, RUNNER_API);
+LLM_DECLARE_TAG_API(Runner_SaveGame, RUNNER_API);
+
+namespace RunnerLLM
+{
+	/** Returns the name of the tag of objects spawned by the given spawner type */
+	RUNNER_API FName GetSpawnerTag(ERunnerSpawnerType SpawnerType);
+
+	/** Returns the names of all runner tags, including the loading screen tag of LoadingScreenModule */
+	RUNNER_API const TArray<FName>& GetAllTags();
+
+	/** Returns the tag name used in reports, e.g. Runner_Tiles */
+	RUNNER_API FString GetReportName(FName Tag);
+
+	/** Returns true if LLM is running, always false in builds without LLM */
+	RUNNER_API bool IsEnabled();
+
+	/** Returns the memory tracked under a tag in bytes, 0 when LLM is not running */
+	RUNNER_API int64 GetTagAmount(FName Tag);
+}
+
+/** Track allocations of the rest of the scope under a runner tag chosen at runtime */
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+#define RUNNER_LLM_SCOPE_BYNAME(TagName) \
+	FLLMScope PREPROCESSOR_JOIN(RunnerLLMScope_, __LINE__)(TagName, false, ELLMTagSet::None, ELLMTracker::Default)
+#else
+#define RUNNER_LLM_SCOPE_BYNAME(TagName)
+#endif
+
+/**
+ *  Accumulates the cost of a code path on the game thread
+ */
+class RUNNER_API FRunnerCostCounter
+{
+public:
+	explicit FRunnerCostCounter(const TCHAR* InName);
+
+	/** Add the duration of one call */
+	void Add(double Seconds);
+
+	void Reset();
+
+	const TCHAR* GetName() const { return Name; }
+
+	int32 GetCallCount() const { return CallCount; }
+
+	double GetTotalSeconds() const { return TotalSeconds; }
+
+	double GetMaxSeconds() const { return MaxSeconds; }
+
+	/** Duration of the latest call */
+	double GetLastSeconds() const { return LastSeconds; }
+
+	/** Duration of every call in milliseconds, only kept while sample recording is enabled */
+	const TArray<float>& GetSamples() const { return Samples; }
+
+	/** Keep every sample of all counters, used by benchmarks to compute percentiles */
+	static void SetRecordSamples(bool bEnabled);
+
+	/** Reset all counters */
+	static void ResetAll();
+
+	/** Returns all counters */
+	static const TArray<FRunnerCostCounter*>& GetAll();
+
+private:
+	const TCHAR* Name;
+
+	int32 CallCount = 0;
+
+	double TotalSeconds = 0;
+
+	double MaxSeconds = 0;
+
+	double LastSeconds = 0;
+
+	TArray<float> Samples;
+
+	static bool bRecordSamples;
+
+	static TArray<FRunnerCostCounter*>& GetRegistry();
+};
+
+/**
+ *  Adds the time spent in the scope to a counter
+ */
+class FRunnerScopedCost
+{
+public:
+	explicit FRunnerScopedCost(FRunnerCostCounter& InCounter)
+		: Counter(InCounter)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FRunnerScopedCost()
+	{
+		Counter.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+	}
+
+private:
+	FRunnerCostCounter& Counter;
+
+	uint64 StartCycles;
+};
+
+/** Counters of the runner code paths */
+namespace RunnerCost
+{
+	extern RUNNER_API FRunnerCostCounter ExtendTile;
+	extern RUNNER_API FRunnerCostCounter AddTile;
+	extern RUNNER_API FRunnerCostCounter RemoveTile;
+	extern RUNNER_API FRunnerCostCounter SpawnObjects;
+	extern RUNNER_API FRunnerCostCounter LayOutObjects;
+	extern RUNNER_API FRunnerCostCounter SaveGame;
+	extern RUNNER_API FRunnerCostCounter CreateWidget;
+}
+
+/** Measure the rest of the scope into one of the RunnerCost counters */
+#define RUNNER_SCOPE_COST(CounterName) FRunnerScopedCost PREPROCESSOR_JOIN(RunnerScopedCost_, __LINE__)(RunnerCost::CounterName)
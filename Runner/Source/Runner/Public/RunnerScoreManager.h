@@ -4,16 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Components/ActorComponent.h"
 #include "RunnerScoreManager.generated.h"
 
+/** Declare a multicast delegate for score value changes, Delta is the net change since the last notification */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRunnerScoreValueChanged, int32, NewValue, int32, Delta);
+
 /**
- * 
+ *  Keeps track of score and coins of the current run.
+ *  Changes are coalesced and listeners are notified at most once per frame.
  */
 UCLASS()
 class RUNNER_API URunnerScoreManager : public UActorComponent
 {
 	GENERATED_BODY()
-	
+
+public:
+	URunnerScoreManager();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
 	virtual void BeginPlay() override;
 
 public:
@@ -37,4 +48,36 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	void SaveTotalCoin();
+
+/**
+ *  Change Notification
+ */
+public:
+	/** Broadcast at most once per frame when the score changed */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnRunnerScoreValueChanged OnScoreChanged;
+
+	/** Broadcast at most once per frame when the coins changed */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnRunnerScoreValueChanged OnCoinsChanged;
+
+	/** Broadcast at most once per frame when the high score changed */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnRunnerScoreValueChanged OnHighScoreChanged;
+
+protected:
+	/** Net score change not yet broadcast */
+	int32 PendingScoreDelta = 0;
+
+	/** Net coin change not yet broadcast */
+	int32 PendingCoinsDelta = 0;
+
+	/** Net high score change not yet broadcast */
+	int32 PendingHighScoreDelta = 0;
+
+	/** Schedule a notification at the end of this frame */
+	void MarkDirty();
+
+	/** Broadcast the pending changes */
+	void FlushChanges();
 };
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "RunnerTickSettings.h"
+#include "RunnerSignificanceSettings.generated.h"
+
+/**
+ *  Significance tier of spawned objects, chosen by their track distance to the player
+ */
+USTRUCT(BlueprintType)
+struct FRunnerSignificanceTier
+{
+	GENERATED_BODY()
+
+	/** Name shown in logs */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	FName Name;
+
+	/** Closest track distance of the tier, negative behind the player */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	float MinDistance = 0.0f;
+
+	/** Farthest track distance of the tier, negative behind the player */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	float MaxDistance = 0.0f;
+
+	/** Objects allowed in the tier, once it is full the farthest ones move to the next tier reaching farther on their side of the player. 0 for no limit */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier", meta = (ClampMin = "0"))
+	int32 MaxObjects = 0;
+
+	/** Tick of the actors and their components, except skeletal meshes */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	ERunnerTickMode TickMode = ERunnerTickMode::Keep;
+
+	/** Seconds between ticks when throttled */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier", meta = (ClampMin = "0", EditCondition = "TickMode == ERunnerTickMode::Throttle"))
+	float TickInterval = 0.1f;
+
+	/** Animation update of the skeletal meshes */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	ERunnerTickMode AnimationMode = ERunnerTickMode::Keep;
+
+	/** Seconds between animation updates when throttled */
+	UPROPERTY(EditAnywhere, Category = "Significance Tier", meta = (ClampMin = "0", EditCondition = "AnimationMode == ERunnerTickMode::Throttle"))
+	float AnimationInterval = 0.1f;
+
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	bool bCastShadows = true;
+
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	bool bCollision = true;
+
+	UPROPERTY(EditAnywhere, Category = "Significance Tier")
+	bool bVisible = true;
+};
+
+/**
+ *  Tiers applied to spawned objects by URunnerSignificanceSubsystem
+ */
+UCLASS(Config = "Game", Defaultconfig, meta = (DisplayName = "Runner Significance Settings"))
+class RUNNER_API URunnerSignificanceSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Tiers from the most to the least significant, an object gets the first tier containing its distance or else the last tier */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	TArray<FRunnerSignificanceTier> Tiers;
+
+	/** Seconds between updates of the tiers */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0"))
+	float UpdateInterval = 0.1f;
+};
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerGenericStruct.h"
+#include "RunnerSignificanceSettings.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerSignificanceSubsystem.generated.h"
+
+/**
+ *  Buckets spawned objects into the tiers of URunnerSignificanceSettings by their track distance to the player,
+ *  and adjusts their ticks, animation updates, shadows, collision and visibility to the tier.
+ *  The state of an object when it is registered is what the tiers reduce from, and what a full tier restores.
+ *
+ *  Outside shipping builds Runner.Significance logs the objects per tier.
+ */
+UCLASS()
+class RUNNER_API URunnerSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Track an object spawned by a spawner of the given type, destroyed objects are dropped on the next update */
+	void Register(AActor* Actor, ERunnerSpawnerType SpawnerType);
+
+	/** Apply the current tier of a tracked object again after its ticks were changed elsewhere, returns false if it is not tracked */
+	bool RefreshTier(AActor* Actor);
+
+	/** Tiers copied from the settings when the world started */
+	const TArray<FRunnerSignificanceTier>& GetTiers() const { return Tiers; }
+
+	/** Number of tracked objects in each tier, in the order of GetTiers */
+	const TArray<int32>& GetTierCounts() const { return TierCounts; }
+
+	/**
+	 *  Assign a tier to each track distance, filling the tiers from the closest object.
+	 *  Objects over the budget of a tier move to its overflow tier, or stay when it has none.
+	 *  SortScratch only keeps its memory between calls.
+	 */
+	static void AssignTiers(TConstArrayView<FRunnerSignificanceTier> InTiers, TConstArrayView<float> Distances,
+		TArray<int32>& SortScratch, TArray<int32>& OutTiers, TArray<int32>& OutTierCounts);
+
+	/** Returns the first tier containing the distance, or else the last tier */
+	static int32 FindDistanceTier(TConstArrayView<FRunnerSignificanceTier> InTiers, float Distance);
+
+	/** Returns the first less significant tier reaching farther on the side of the distance, INDEX_NONE if there is none */
+	static int32 FindOverflowTier(TConstArrayView<FRunnerSignificanceTier> InTiers, int32 Tier, float Distance);
+
+#if !UE_BUILD_SHIPPING
+	/** Log the tracked objects per tier */
+	void LogTiers() const;
+#endif
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Registered state of a component the tiers change */
+	struct FComponentState
+	{
+		TWeakObjectPtr<UActorComponent> Component;
+
+		bool bAnimation = false;
+
+		bool bTickEnabled = false;
+
+		float TickInterval = 0.0f;
+
+		bool bCastShadow = false;
+	};
+
+	/** Tracked object with its registered state */
+	struct FSignificanceEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		ERunnerSpawnerType SpawnerType = ERunnerSpawnerType::Other;
+
+		/** Applied tier, INDEX_NONE before the first update */
+		int32 Tier = INDEX_NONE;
+
+		/** Track distance to the player, negative behind the player */
+		float Distance = 0.0f;
+
+		bool bTickEnabled = false;
+
+		float TickInterval = 0.0f;
+
+		bool bCollision = true;
+
+		bool bHidden = false;
+
+		TArray<FComponentState, TInlineAllocator<4>> Components;
+	};
+
+	TArray<FRunnerSignificanceTier> Tiers;
+
+	TArray<FSignificanceEntry> Entries;
+
+	/** Scratch arrays of UpdateTiers, kept to reuse their memory */
+	TArray<float> EntryDistances;
+
+	TArray<int32> AssignedTiers;
+
+	TArray<int32> SortedEntries;
+
+	TArray<int32> TierCounts;
+
+	float UpdateInterval = 0.1f;
+
+	float TimeUntilUpdate = 0.0f;
+
+	/** Assign the tiers and apply the changed ones */
+	void UpdateTiers();
+
+	void ApplyTier(FSignificanceEntry& Entry, const FRunnerSignificanceTier& Tier) const;
+};
@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "RunnerSimulation.generated.h"
+
+/**
+ *  Settings of the fixed-timestep runner simulation
+ */
+USTRUCT(BlueprintType)
+struct FRunnerSimConfig
+{
+	GENERATED_BODY()
+
+	/** Simulation steps per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation", meta = (ClampMin = "1"))
+	int32 StepRate = 60;
+
+	/** Maximum steps per frame, the simulation falls behind instead of spiraling on long frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation", meta = (ClampMin = "1"))
+	int32 MaxStepsPerFrame = 8;
+
+	/** Seed of the simulation random stream */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
+	int32 Seed = 0;
+
+	/** Speed at the start of a run */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Speed")
+	float StartSpeed = 500;
+
+	/** Speed increment per passed tile when tiles are derived from the track position */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Speed")
+	float SpeedIncrement = 10;
+
+	/** Maximum speed when tiles are derived from the track position */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Speed")
+	float MaxSpeed = 1500;
+
+	/** Length of a tile, tiles are derived from the track position when greater than zero, otherwise they are passed in as input */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Track")
+	float TileLength = 0;
+
+	/** Y-axis lane offsets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Lane")
+	TArray<float> LaneYOffsets = {-325, 0, 325};
+
+	/** Lane at the start of a run */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Lane")
+	int32 StartLaneIndex = 1;
+
+	/** Time it takes to switch lane in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Lane")
+	float LaneSwitchDuration = 0.2f;
+
+	/** Duration of a slide in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Effects")
+	float SlideDuration = 1;
+
+	/** Duration of a jump in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Effects")
+	float JumpDuration = 0.8f;
+
+	/** Duration of the magnet effect in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Effects")
+	float MagnetDuration = 3;
+};
+
+/**
+ *  Gameplay state of a run, advanced in fixed steps
+ */
+USTRUCT(BlueprintType)
+struct FRunnerSimState
+{
+	GENERATED_BODY()
+
+	/** Distance travelled along the track */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	double TrackPosition = 0;
+
+	/** Forward speed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float Speed = 0;
+
+	/** Number of tiles passed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	int32 TileIndex = 0;
+
+	/** Lane the player is in, updated when a lane switch finishes */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	int32 LaneIndex = 0;
+
+	/** Lane the player is switching to */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	int32 TargetLaneIndex = 0;
+
+	/** Progress of the current lane switch, 1 when not switching */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float LaneSwitchAlpha = 1;
+
+	/** Y-axis position derived from the lane switch */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float LateralPosition = 0;
+
+	/** Time left of the slide */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float SlideTimeRemaining = 0;
+
+	/** Time left of the jump */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float AirTimeRemaining = 0;
+
+	/** Time left of the magnet effect */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float MagnetTimeRemaining = 0;
+
+	/** The simulation does not advance while the player is dead */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	bool bIsDead = false;
+
+	/** Number of steps since reset */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	int64 StepCount = 0;
+
+	bool IsSwitchingLane() const { return LaneIndex != TargetLaneIndex; }
+	bool IsSliding() const { return SlideTimeRemaining > 0; }
+	bool IsAirborne() const { return AirTimeRemaining > 0; }
+	bool IsMagnetActive() const { return MagnetTimeRemaining > 0; }
+};
+
+/**
+ *  Commands applied at the start of a step
+ */
+struct FRunnerSimInput
+{
+	/** Lane change requested, -1 for left and 1 for right */
+	int32 LaneOffset = 0;
+
+	bool bSlide = false;
+
+	bool bJump = false;
+
+	bool bMagnet = false;
+
+	/** Tiles passed since the last step, used when tiles are not derived from the track position */
+	int32 TilesPassed = 0;
+
+	/** Speed increment per passed tile */
+	float TileSpeedIncrement = 0;
+
+	/** Speed cap applied for passed tiles */
+	float TileMaxSpeed = 0;
+
+	void Reset() { *this = FRunnerSimInput(); }
+};
+
+/**
+ *  Transitions that happened during a step
+ */
+struct FRunnerSimEvents
+{
+	bool bLaneSwitchFinished = false;
+	bool bSlideEnded = false;
+	bool bJumpEnded = false;
+	bool bMagnetEnded = false;
+	int32 TilesPassed = 0;
+
+	FRunnerSimEvents& operator|=(const FRunnerSimEvents& Other)
+	{
+		bLaneSwitchFinished |= Other.bLaneSwitchFinished;
+		bSlideEnded |= Other.bSlideEnded;
+		bJumpEnded |= Other.bJumpEnded;
+		bMagnetEnded |= Other.bMagnetEnded;
+		TilesPassed += Other.TilesPassed;
+		return *this;
+	}
+};
+
+/**
+ *  Deterministic fixed-timestep runner simulation.
+ *  Holds no engine objects, the same seed and inputs always produce the same states,
+ *  so it can be stepped by a world component or faster than real time without a world.
+ */
+class RUNNER_API FRunnerSimulation
+{
+public:
+	FRunnerSimulation() = default;
+
+	explicit FRunnerSimulation(const FRunnerSimConfig& InConfig);
+
+	/** Reset the state and the random stream to the start of a run */
+	void Reset(const FRunnerSimConfig& InConfig);
+
+	/** Advance the state by one fixed step */
+	FRunnerSimEvents Step(const FRunnerSimInput& Input);
+
+	/** Move the player to the given lane without a transition */
+	void SetLane(int32 InLaneIndex);
+
+	/** Stop or restart the simulation when the player dies or resumes */
+	void SetDead(bool bInDead) { State.bIsDead = bInDead; }
+
+	/** Change the speed settings of tiles derived from the track position, applies from the next passed tile */
+	void SetTileSpeed(float InSpeedIncrement, float InMaxSpeed);
+
+	/** Returns the lateral position of the given lane */
+	float GetLaneY(int32 InLaneIndex) const;
+
+	/** Returns the duration of a step in seconds */
+	float GetStepSeconds() const { return StepSeconds; }
+
+	const FRunnerSimConfig& GetConfig() const { return Config; }
+
+	const FRunnerSimState& GetState() const { return State; }
+
+	/** Random stream for gameplay decisions, seeded from the config */
+	FRandomStream& GetRandomStream() { return RandomStream; }
+
+private:
+	FRunnerSimConfig Config;
+
+	FRunnerSimState State;
+
+	FRandomStream RandomStream;
+
+	float StepSeconds = 1.0f / 60.0f;
+
+	/** Apply the speed increment of a passed tile */
+	void PassTile(float Increment, float Max);
+
+	/** Count down an effect timer, returns true when it ran out during this step */
+	static bool TickTimer(float& TimeRemaining, float DeltaSeconds);
+};
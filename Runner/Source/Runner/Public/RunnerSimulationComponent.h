@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerSimulation.h"
+#include "Components/ActorComponent.h"
+#include "RunnerSimulationComponent.generated.h"
+
+/**
+ *  Runs the runner simulation at a fixed rate from the variable frame time of the world.
+ *  Commands are queued and applied on the next step, rendering reads states interpolated between the last two steps.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class RUNNER_API URunnerSimulationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	URunnerSimulationComponent();
+
+	/** Simulation settings, lane and duration values are usually copied from the owner before reset */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Simulation")
+	FRunnerSimConfig Config;
+
+	/** Reset the simulation to the start of a run using Config */
+	UFUNCTION(BlueprintCallable)
+	void ResetSimulation();
+
+	/** Run the steps covered by the given frame time, returns the transitions of all steps */
+	FRunnerSimEvents Advance(float DeltaTime);
+
+	/** Queue a lane change for the next step */
+	void QueueLaneSwitch(int32 LaneOffset);
+
+	/** Queue a slide for the next step */
+	void QueueSlide();
+
+	/** Queue a jump for the next step */
+	void QueueJump();
+
+	/** Queue the magnet effect for the next step */
+	void QueueMagnet();
+
+	/** Queue a passed tile with its speed settings for the next step */
+	void QueueTilePassed(float SpeedIncrement, float MaxSpeed);
+
+	/** Change the speed settings of tiles derived from the track position */
+	void SetTileSpeed(float SpeedIncrement, float MaxSpeed);
+
+	/** Move the player to the given lane without a transition */
+	void SetLane(int32 LaneIndex);
+
+	/** Stop or restart the simulation */
+	void SetDead(bool bIsDead);
+
+	/** Returns the state of the last step */
+	const FRunnerSimState& GetState() const { return Simulation.GetState(); }
+
+	/** Returns the state of the step before the last one */
+	const FRunnerSimState& GetPreviousState() const { return PreviousState; }
+
+	/** Returns how far the frame time is between the last two steps, in range [0, 1] */
+	float GetInterpolationAlpha() const;
+
+	/** Returns the lateral position interpolated for rendering, shaped by the given lane switch curve */
+	float GetInterpolatedLateralPosition(const UCurveFloat* LaneSwitchCurve = nullptr) const;
+
+	/** Returns the speed interpolated for rendering */
+	float GetInterpolatedSpeed() const;
+
+	/** Direct access for tools that step the simulation themselves */
+	FRunnerSimulation& GetSimulation() { return Simulation; }
+
+private:
+	FRunnerSimulation Simulation;
+
+	/** State before the last step, used for interpolation */
+	FRunnerSimState PreviousState;
+
+	/** Commands for the next step */
+	FRunnerSimInput PendingInput;
+
+	/** Frame time not yet consumed by steps */
+	float Accumulator = 0;
+};
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerSoakSubsystem.generated.h"
+
+/**
+ *  Long autopilot run through repeated death and resume cycles that fails when objects or memory keep growing.
+ *  Created only when the game is started with -RunnerSoak, which also enables the autopilot.
+ *  Samples are written to Saved/Profiling/RunnerSoak-<date>.csv and the game quits with a non-zero exit code on a leak.
+ *
+ *  Usage: Runner.uproject /Game/Runner/Maps/RunnerMap_L1 -game -nullrhi -unattended -RunnerSoak
+ *         [-SoakDuration=3600] [-SoakSampleTiles=50] [-SoakDeathTiles=25] [-SoakReport=<csv path>]
+ */
+UCLASS()
+class RUNNER_API URunnerSoakSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Returns true if the series grows steadily by more than the tolerance, the growth is returned in OutGrowth.
+	 * The growth comes from a least squares fit and at least 80% of the steps must not decrease.
+	 */
+	static bool IsGrowing(const TArray<double>& Series, double AbsoluteTolerance, double RelativeTolerance, double& OutGrowth);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** One sample of the live counts */
+	struct FSoakSample
+	{
+		int32 Tile = 0;
+		double Seconds = 0;
+		int32 Deaths = 0;
+		int32 UObjects = 0;
+		double UsedPhysicalMB = 0;
+
+		/** Live objects by class */
+		TMap<FName, int32> ClassCounts;
+	};
+
+	/** Real time to run */
+	double DurationSeconds = 3600;
+
+	/** Tiles between samples */
+	int32 SampleTiles = 50;
+
+	/** Tiles after which the runner is killed if the autopilot has not died */
+	int32 DeathTiles = 25;
+
+	FString ReportPath;
+
+	bool bStarted = false;
+
+	bool bFinished = false;
+
+	double StartTime = 0;
+
+	int32 StartTileIndex = 0;
+
+	int32 NextSampleTile = 0;
+
+	int32 LastDeathTile = 0;
+
+	int32 Deaths = 0;
+
+	bool bWasDead = false;
+
+	TArray<FSoakSample> Samples;
+
+	void TakeSample(int32 Tile);
+
+	/** Check the samples for growth, write the report and quit */
+	void Finish();
+
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RunnerSpawnAllocCommandlet.generated.h"
+
+struct FSpawnSettings;
+
+namespace RunnerSpawnAlloc
+{
+	/** Heap allocations counted while laying out tiles */
+	struct FLayoutAllocations
+	{
+		/** Tiles that allocated at least once */
+		int32 FailedTiles = 0;
+
+		/** Game thread allocations of all counted tiles */
+		int32 Allocations = 0;
+
+		/** Objects laid out on the counted tiles */
+		int32 Objects = 0;
+	};
+
+	/**
+	 *  Lay out the spawners on the warm-up tiles, then count the game thread heap allocations of each of the following tiles.
+	 *  Only the layout is counted, creating the spawned actors is not.
+	 */
+	RUNNER_API FLayoutAllocations CountLayoutAllocations(TConstArrayView<const FSpawnSettings*> Spawners, const FVector& FloorExtent, int32 Tiles, int32 WarmupTiles);
+}
+
+/**
+ *  Checks that laying out tiles does not allocate heap memory once warmed up, creating the spawned actors is not covered.
+ *  The floor spawners are laid out with the same code as the spawn components while game thread allocations are counted,
+ *  the commandlet fails if any tile after the warm-up allocated. Runner.Spawn.LayoutIsAllocationFree runs the same check on fixed settings.
+ *
+ *  Usage: -run=RunnerSpawnAlloc [-Tiles=100] [-WarmupTiles=10] [-TileClass=<class path>]
+ */
+UCLASS()
+class RUNNER_API URunnerSpawnAllocCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URunnerSpawnAllocCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
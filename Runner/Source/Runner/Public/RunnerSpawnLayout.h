@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerGenericStruct.h"
+#include "Math/RandomStream.h"
+
+/**
+ *  Layout rules for objects spawned on a tile.
+ *  Shared by the spawn components in the world and by tools simulating runs without a world.
+ */
+namespace RunnerSpawnLayout
+{
+	/** Returns true if objects with the given interval should spawn on the given tile */
+	RUNNER_API bool ShouldSpawnOnTile(int32 TileCount, int32 SpawnIntervalBase, int32 SpawnIntervalRandomOffset, const FRandomStream& RandomStream);
+
+	/** Returns the number of spawn points in the grid of the settings */
+	RUNNER_API int32 GetSpawnPointNum(const FSpawnSettings& Settings);
+
+	/** Generates the grid of spawn transforms, relative to the center of a floor with the given extent, into a view of GetSpawnPointNum entries */
+	RUNNER_API void GenerateSpawnGrid(const FSpawnSettings& Settings, const FVector& FloorExtent, TArrayView<FTransform> OutTransforms);
+
+	/** Generates the grid of spawn transforms, relative to the center of a floor with the given extent */
+	RUNNER_API void GenerateSpawnGrid(const FSpawnSettings& Settings, const FVector& FloorExtent, TArray<FTransform>& OutTransforms);
+
+	/** Shuffles the spawn transforms so the first ActorNum entries are the picked spawn points */
+	RUNNER_API void ShuffleSpawnPoints(TArrayView<FTransform> SpawnTransforms, const FRandomStream& RandomStream);
+
+	/** Applies the random rotation and Z-axis options of the settings to a picked transform */
+	RUNNER_API void RandomizeTransform(const FSpawnSettings& Settings, FTransform& InOutTransform, const FRandomStream& RandomStream);
+
+	/** Picks the class to spawn, returns nullptr if the settings have no class */
+	RUNNER_API UClass* PickActorClass(const FSpawnSettings& Settings, const FRandomStream& RandomStream);
+
+	/**
+	 *  Lays out the objects of one spawner on a floor with the given extent and calls Spawn with each picked class and transform.
+	 *  The spawn points live on the memory stack of the calling thread, so no heap memory is allocated once its pages exist.
+	 */
+	RUNNER_API void LayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+		TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn);
+
+	/** Lays out the objects of one spawner on a spawn grid generated earlier for the settings */
+	RUNNER_API void LayOutObjects(const FSpawnSettings& Settings, TConstArrayView<FTransform> SpawnGrid, const FRandomStream& RandomStream,
+		TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn);
+}
@@ -10,6 +10,8 @@
 
 class UArrowComponent;
 class UChildActorComponent;
+class UInstancedStaticMeshComponent;
+class URunnerSpawnProfile;
 
 /**
  * An actor component responsible for spawning objects attached to the specified child actor component.
@@ -22,38 +24,94 @@ class RUNNER_API URunnerSpawnObjectsComponent : public UActorComponent
 public:	
 	URunnerSpawnObjectsComponent();
 
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
 public:
-	/** Spawn options */
+	/** Shared spawn options, replaces SpawnSettings when set */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Spawn Objects")
+	TObjectPtr<URunnerSpawnProfile> SpawnProfile;
+
+	/** Spawn options of this spawner, used when no SpawnProfile is set */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Spawn Objects", meta = (EditCondition = "SpawnProfile == nullptr"))
 	FSpawnSettings SpawnSettings;
 
+	/** Returns the spawn options in use, those of the profile if one is set */
+	const FSpawnSettings& GetSpawnSettings() const;
+
+	/** Kind of objects this spawner places */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Spawn Objects")
+	ERunnerSpawnerType SpawnerType = ERunnerSpawnerType::Other;
+
 	/** Color of visualize arrow */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Spawn Objects")
 	FColor ArrowColor = FColor::Green;
+
+	/** The objects may be planned with proxies on far tiles and spawned when the player gets close */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Spawn Objects")
+	bool bAllowDeferredSpawn = true;
 	
 	/** Spawns the objects in the editor */
 	UFUNCTION(BlueprintCallable)
 	void SpawnObjects(UChildActorComponent* AttachParent);
 
+	/** Spawns the objects using the given random stream for the layout */
+	void SpawnObjects(UChildActorComponent* AttachParent, const FRandomStream& RandomStream);
+
+	/** Lays out the objects without spawning them and shows instanced meshes without collision in their place */
+	void PlanObjects(UChildActorComponent* AttachParent, const FRandomStream& RandomStream);
+
+	/** Spawns the objects laid out by PlanObjects and removes their proxies */
+	void MaterializeObjects();
+
+	/** Returns true if objects are laid out but not spawned yet */
+	bool HasPlannedObjects() const { return PlannedObjects.Num() > 0; }
+
 	/** Removes the objects */
 	UFUNCTION(BlueprintCallable)
 	void RemoveObjects();
 
+	/** Removes the objects behind the track position and those destroyed during play, returns the number removed */
+	int32 ReclaimObjectsBehind(double TrackX);
+
+	/** Returns the components holding the spawned objects */
+	TConstArrayView<UChildActorComponent*> GetSpawnedObjects() const { return SpawnedObjects; }
+
 protected:
-	/** Array to store spawned objects */
-	TArray<UChildActorComponent*> SpawnedObjects;
+	/** Array to store spawned objects, inline so filling a new tile does not allocate */
+	TArray<UChildActorComponent*, TInlineAllocator<16>> SpawnedObjects;
 
 	/** Arrow components used for visualization */
 	TArray<UArrowComponent*> SpawnedArrows;
-	
+
+	/** Object laid out by PlanObjects */
+	struct FPlannedObject
+	{
+		UClass* ActorClass;
+		FTransform SpawnTransform;
+	};
+
+	/** Objects to spawn on MaterializeObjects, the classes are kept alive by the spawn settings */
+	TArray<FPlannedObject, TInlineAllocator<16>> PlannedObjects;
+
+	/** Attach parent of the planned objects */
+	UPROPERTY()
+	TObjectPtr<UChildActorComponent> PlannedAttachParent;
+
+	/** Instanced meshes standing in for the planned objects, one per mesh */
+	UPROPERTY()
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> ProxyComponents;
+
+	/** Lays out the objects on the attach parent and passes each picked class and transform to Place, returns false if nothing is laid out */
+	bool LayOutObjects(UChildActorComponent* AttachParent, const FRandomStream& RandomStream, TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Place);
+
 	/** Creates and spawns a new object at the specified transform */
 	void SpawnObjectClass(UClass* ActorClass, const FTransform& SpawnTransform, UChildActorComponent* AttachParent);
 
-	/** Generates spawn transforms for the object */
-	TArray<FTransform> GenerateSpawnTransform(const UChildActorComponent* AttachParent) const;
+	/** Adds a proxy instance of the class at the specified transform */
+	void AddProxyInstance(UClass* ActorClass, const FTransform& SpawnTransform, UChildActorComponent* AttachParent);
 
-	/** Calculates the floor extent based on the given child actor component. */
-	FVector CalculateFloorExtent(const UChildActorComponent* AttachParent) const;
+	/** Remove the planned objects and their proxies */
+	void RemovePlannedObjects();
 
 	/** Iterate over the spawned objects and remove any that overlap with existing objects in the level. */
 	void ResolveOverlaps();
@@ -61,8 +119,8 @@ protected:
 	/** Adds an arrow for visualization */
 	void AddArrowComponent(const FVector& Location, const FColor& Color, UChildActorComponent* AttachParent);
 	
-	/** Visualizes the spawn locations */
-	void VisualizeSpawnLocations(const TArray<FTransform>& SpawnTransforms, UChildActorComponent* AttachParent);
+	/** Visualizes the spawn locations on a floor with the given extent */
+	void VisualizeSpawnLocations(const FVector& FloorExtent, UChildActorComponent* AttachParent);
 
 	/** Remove all existing arrows */
 	void RemoveArrowComponents();
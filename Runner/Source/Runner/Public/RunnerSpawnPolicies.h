@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerSpawnLayout.h"
+
+/**
+ *  Spawn layout specialized at compile time for one grid shape and set of random options.
+ *  Produces the same objects and consumes the same random numbers as RunnerSpawnLayout::LayOutObjects,
+ *  but shuffles point indices instead of transforms and only builds the transforms of the picked points.
+ */
+template <int32 InLaneNum, int32 InPointsPerLane, bool bInRandomRotator, bool bInRandomZaxis>
+struct TRunnerSpawnPolicy
+{
+	static constexpr int32 LaneNum = InLaneNum;
+	static constexpr int32 PointsPerLane = InPointsPerLane;
+	static constexpr int32 PointNum = InLaneNum * InPointsPerLane;
+	static constexpr bool bRandomRotator = bInRandomRotator;
+	static constexpr bool bRandomZaxis = bInRandomZaxis;
+
+	static_assert(LaneNum > 0 && PointsPerLane > 0, "Spawn policies need at least one spawn point");
+	static_assert(PointNum <= MAX_uint8, "Spawn point indices are stored as uint8");
+
+	/** Returns true if the settings have the grid shape and options of the policy */
+	static bool Matches(const FSpawnSettings& Settings)
+	{
+		return Settings.LaneYOffsets.Num() == LaneNum
+			&& Settings.PointsPerLane == PointsPerLane
+			&& Settings.bRandomRotator == bRandomRotator
+			&& Settings.bRandomZaxis == bRandomZaxis;
+	}
+
+	/** Lays out the objects of settings matching the policy and calls Spawn with each picked class and transform */
+	template <typename SpawnFuncType>
+	static void LayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream, SpawnFuncType&& Spawn)
+	{
+		checkSlow(Matches(Settings));
+
+		// Fisher-Yates shuffle of the point indices, same draws as RunnerSpawnLayout::ShuffleSpawnPoints
+		uint8 Order[PointNum];
+		FMemory::Memcpy(Order, IdentityOrder.Indices, PointNum);
+		for (int32 i = PointNum - 1; i > 0; --i)
+		{
+			const int32 SwapIndex = RandomStream.RandRange(0, i);
+			Swap(Order[i], Order[SwapIndex]);
+		}
+
+		// Same spacing as RunnerSpawnLayout::GenerateSpawnGrid
+		const float FloorWidth = FloorExtent.X * 2;
+		const float UsableWidth = FloorWidth - (2 * Settings.XOffset);
+		const float SpacingX = UsableWidth / (PointsPerLane + 1);
+		const FQuat BaseRotation = Settings.ActorRotator.Quaternion();
+
+		const int32 SpawnNum = FMath::Min(Settings.ActorNum, PointNum);
+		for (int32 i = 0; i < SpawnNum; ++i)
+		{
+			UClass* ActorClass = RunnerSpawnLayout::PickActorClass(Settings, RandomStream);
+
+			// Grid points are ordered by point, then by lane
+			const int32 Point = Order[i] / LaneNum;
+			const int32 Lane = Order[i] % LaneNum;
+			FVector Location(Settings.XOffset + (SpacingX * (Point + 1) - FloorExtent.X), Settings.LaneYOffsets[Lane], Settings.ZOffset);
+			FQuat Rotation = BaseRotation;
+
+			if constexpr (bRandomRotator)
+			{
+				FRotator NewRotation = Rotation.Rotator();
+				NewRotation.Yaw = RandomStream.FRandRange(0.0f, 270.0f);
+				Rotation = NewRotation.Quaternion();
+			}
+
+			if constexpr (bRandomZaxis)
+			{
+				Location.Z = RandomStream.FRandRange(-50.0f, 50.0f);
+			}
+
+			Spawn(ActorClass, FTransform(Rotation, Location));
+		}
+	}
+
+private:
+	/** Point indices in grid order, built at compile time */
+	struct FIdentityOrder
+	{
+		uint8 Indices[PointNum];
+
+		constexpr FIdentityOrder()
+			: Indices()
+		{
+			for (int32 i = 0; i < PointNum; ++i)
+			{
+				Indices[i] = static_cast<uint8>(i);
+			}
+		}
+	};
+
+	static constexpr FIdentityOrder IdentityOrder{};
+};
+
+/**
+ *  Specialized layouts of the common spawners, the generic layout stays the fallback for any other settings.
+ */
+namespace RunnerSpawnPolicies
+{
+	/** Coin and powerup rows on the three floor lanes */
+	using FLaneRowPolicy = TRunnerSpawnPolicy<3, 6, false, false>;
+
+	/** Obstacle slots on the three floor lanes */
+	using FLaneSlotPolicy = TRunnerSpawnPolicy<3, 2, false, false>;
+
+	/** Skyline props scattered along one lane */
+	using FScatterPolicy = TRunnerSpawnPolicy<1, 6, false, false>;
+	using FScatterRotatedPolicy = TRunnerSpawnPolicy<1, 6, true, false>;
+	using FScatterRotatedRaisedPolicy = TRunnerSpawnPolicy<1, 6, true, true>;
+
+	/** Lays out the objects with a specialized policy, returns false without drawing random numbers if no policy matches the settings */
+	RUNNER_API bool TryLayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+		TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn);
+
+	/** Lays out the objects with a specialized policy if one matches the settings, otherwise with the generic layout */
+	RUNNER_API void LayOutObjects(const FSpawnSettings& Settings, const FVector& FloorExtent, const FRandomStream& RandomStream,
+		TFunctionRef<void(UClass* ActorClass, const FTransform& SpawnTransform)> Spawn);
+}
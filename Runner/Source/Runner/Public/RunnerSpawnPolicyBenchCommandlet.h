@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerGenericStruct.h"
+#include "Commandlets/Commandlet.h"
+#include "RunnerSpawnPolicyBenchCommandlet.generated.h"
+
+namespace RunnerSpawnPolicyBench
+{
+	/** Settings laid out by one spawn policy */
+	struct FBenchCase
+	{
+		const TCHAR* Name;
+		FSpawnSettings Settings;
+		bool (*Matches)(const FSpawnSettings&);
+	};
+
+	/** Returns settings shaped like the floor and skyline spawners, one per policy */
+	RUNNER_API TArray<FBenchCase> MakeCases();
+}
+
+/**
+ *  Measures the specialized spawn policies against the generic spawn layout and logs the time per layout of both paths.
+ *  Runner.Spawn.PoliciesMatchGenericLayout checks that the policies lay out the same objects as the generic layout.
+ *
+ *  Usage: -run=RunnerSpawnPolicyBench [-Iterations=200000] [-Seed=1] [-TileLength=1000]
+ */
+UCLASS()
+class RUNNER_API URunnerSpawnPolicyBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URunnerSpawnPolicyBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "RunnerGenericStruct.h"
+#include "RunnerSpawnProfile.generated.h"
+
+/**
+ *  Spawn settings shared by every spawner that references the profile.
+ *  Tiles point at the profile instead of carrying their own copy, the settings are read only at runtime.
+ */
+UCLASS(BlueprintType)
+class RUNNER_API URunnerSpawnProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawn Settings")
+	FSpawnSettings SpawnSettings;
+};
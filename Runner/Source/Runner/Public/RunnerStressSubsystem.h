@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerStressSubsystem.generated.h"
+
+class ARunnerFloorActor;
+struct FSpawnSettings;
+struct FRunnerSimConfig;
+
+/**
+ *  Runtime overrides applied to floor tiles while stress testing
+ */
+USTRUCT(BlueprintType)
+struct FRunnerStressSettings
+{
+	GENERATED_BODY()
+
+	/** Multiplier of ActorNum on all floor spawners */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress")
+	float DensityMultiplier = 1;
+
+	/** Multiplier of the lane count on all floor spawners */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress")
+	int32 LaneMultiplier = 1;
+
+	/** Speed forced on the player through the floor tiles, 0 keeps the tile settings */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress")
+	float ForcedMaxSpeed = 0;
+
+	bool IsDefault() const { return DensityMultiplier == 1 && LaneMultiplier == 1 && ForcedMaxSpeed <= 0; }
+};
+
+/**
+ *  Applies stress settings to new floor tiles and runs the density ramp, not available in shipping builds.
+ *  Driven by the RunnerStress cheats of URunnerCheatManager, -RunnerStressRamp[=<budget ms>] runs the ramp at start and quits.
+ */
+UCLASS()
+class RUNNER_API URunnerStressSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	/** Ticks while paused so a ramp ends when the player dies and the game pauses */
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	virtual TStatId GetStatId() const override;
+
+	const FRunnerStressSettings& GetSettings() const { return Settings; }
+
+	/** Use the settings for new tiles and for the tile speed of the tiles already in the world and of the player simulation */
+	void SetSettings(const FRunnerStressSettings& InSettings);
+
+	/** Apply the settings to a floor tile before it spawns its objects */
+	void ApplyToFloor(ARunnerFloorActor& Floor) const;
+
+	/** Apply the forced speed to the tile settings of a player simulation before it resets */
+	void ApplyToSimulation(FRunnerSimConfig& Config) const;
+
+	/** Raise or lower the floor tiles kept ahead of the player, tiles are added right away */
+	void SetTilesAhead(int32 TilesAhead);
+
+	/** Generate the given number of floor tiles now and move the player onto the first new one */
+	void FastForward(int32 Tiles);
+
+	/** Increase the density until the frame time crosses the budget, then log the breaking point */
+	void StartRamp(float BudgetMs);
+
+	void StopRamp();
+
+	bool IsRamping() const { return bRamping; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FRunnerStressSettings Settings;
+
+	/** Density ramp */
+	bool bRamping = false;
+
+	bool bQuitAfterRamp = false;
+
+	float RampBudgetMs = 16.6f;
+
+	/** Frames of the current step, reserved when the ramp starts */
+	TArray<float> RampFrameTimes;
+
+	/** Time left before the current step is measured, lets streaming and GC settle after the tiles are regenerated */
+	float RampSettleTime = 0;
+
+	float RampSampleTime = 0;
+
+	/** Last step that stayed within the budget */
+	float LastPassingDensity = 0;
+
+	TArray<FString> RampReport;
+
+	/** Apply the next density and regenerate the tiles */
+	void BeginRampStep(float Density);
+
+	void FinishRamp(const FString& Result);
+
+	/** Spawn settings with the stress settings applied */
+	void ApplyToSpawnSettings(FSpawnSettings& SpawnSettings) const;
+};
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  One frame of runner telemetry
+ */
+struct FRunnerTelemetrySample
+{
+	/** Seconds since the recording started */
+	float Time = 0;
+
+	float FrameTimeMs = 0;
+
+	/** MaxWalkSpeed of the runner */
+	float Speed = 0;
+
+	/** Tiles added by the floor manager */
+	int32 TileCount = 0;
+
+	int32 LiveActors = 0;
+
+	/** SpawnObjects calls during the frame */
+	uint16 SpawnCalls = 0;
+
+	/** Time spent in SpawnObjects during the frame */
+	float SpawnMs = 0;
+
+	bool bMagnetActive = false;
+};
+
+/**
+ *  Records frames into a preallocated ring buffer with one array per column, recording never allocates.
+ *  The buffer is saved to a compact binary file, oldest frame first, which can be exported to CSV.
+ */
+class RUNNER_API FRunnerTelemetryRecorder
+{
+public:
+	/** Allocate room for the given number of frames and clear the buffer */
+	void Init(int32 InCapacity);
+
+	/** Record a frame, overwrites the oldest frame once the buffer is full */
+	void Record(const FRunnerTelemetrySample& Sample);
+
+	/** Number of frames in the buffer */
+	int32 Num() const { return Count; }
+
+	/** Number of frames recorded since Init, including overwritten ones */
+	int64 GetTotalRecorded() const { return TotalRecorded; }
+
+	/** Returns a frame, 0 is the oldest */
+	FRunnerTelemetrySample GetSample(int32 Index) const;
+
+	/** Session description stored in the file header */
+	FString Session;
+
+	bool SaveToFile(const FString& Path) const;
+
+	bool LoadFromFile(const FString& Path);
+
+	bool ExportCsv(const FString& Path) const;
+
+private:
+	TArray<float> Times;
+	TArray<float> FrameTimesMs;
+	TArray<float> Speeds;
+	TArray<int32> TileCounts;
+	TArray<int32> LiveActors;
+	TArray<uint16> SpawnCalls;
+	TArray<float> SpawnMs;
+	TArray<uint8> MagnetActive;
+
+	int32 Capacity = 0;
+
+	/** Index the next frame is written to */
+	int32 Head = 0;
+
+	int32 Count = 0;
+
+	int64 TotalRecorded = 0;
+
+	/** Buffer index of the oldest frame */
+	int32 GetFirstIndex() const { return Count < Capacity ? 0 : Head; }
+
+	/** Write the frames of a column oldest first */
+	template <typename T>
+	void WriteColumn(FArchive& Ar, const TArray<T>& Column) const;
+};
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RunnerTelemetryExportCommandlet.generated.h"
+
+/**
+ *  Exports telemetry files written by URunnerTelemetrySubsystem to CSV.
+ *  A directory input exports every .rtel file in it, the CSV files are written next to the inputs unless -Output= is given.
+ *
+ *  Usage: -run=RunnerTelemetryExport -Input=<.rtel file or directory> [-Output=<.csv file or directory>]
+ */
+UCLASS()
+class RUNNER_API URunnerTelemetryExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URunnerTelemetryExportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerTelemetry.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerTelemetrySubsystem.generated.h"
+
+/**
+ *  Records per-frame runner telemetry and saves it when the player dies and when the world is torn down.
+ *  Created only when the game is started with -RunnerTelemetry. Files are written to Saved/Telemetry, see URunnerTelemetryExportCommandlet.
+ *
+ *  Usage: -RunnerTelemetry [-TelemetryFrames=36000] [-TelemetryDir=<directory>]
+ */
+UCLASS()
+class RUNNER_API URunnerTelemetrySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Save the recorded frames, the file is rewritten with the latest frames on every flush */
+	void Flush();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FRunnerTelemetryRecorder Recorder;
+
+	FString FilePath;
+
+	double StartTime = 0;
+
+	bool bWasDead = false;
+
+	/** SpawnObjects counter totals of the previous frame */
+	int32 LastSpawnCalls = 0;
+
+	double LastSpawnSeconds = 0;
+};
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "RunnerGenericStruct.h"
+#include "RunnerTickSettings.generated.h"
+
+/**
+ *  What happens to the tick of a matching actor or component
+ */
+UENUM(BlueprintType)
+enum class ERunnerTickMode : uint8
+{
+	Keep,
+	Disable,
+	Throttle
+};
+
+/**
+ *  Tick policy of an actor or component class and its subclasses
+ */
+USTRUCT(BlueprintType)
+struct FRunnerTickPolicy
+{
+	GENERATED_BODY()
+
+	/** Actor or component class the policy applies to */
+	UPROPERTY(EditAnywhere, Category = "Tick Policy", meta = (AllowAbstract = "true"))
+	TSoftClassPtr<UObject> Class;
+
+	UPROPERTY(EditAnywhere, Category = "Tick Policy")
+	ERunnerTickMode Mode = ERunnerTickMode::Disable;
+
+	/** Seconds between ticks when throttled */
+	UPROPERTY(EditAnywhere, Category = "Tick Policy", meta = (ClampMin = "0", EditCondition = "Mode == ERunnerTickMode::Throttle"))
+	float TickInterval = 0.1f;
+};
+
+/**
+ *  Tick policies applied to tiles and spawned objects as they are created
+ */
+UCLASS(Config = "Game", Defaultconfig, meta = (DisplayName = "Runner Tick Settings"))
+class RUNNER_API URunnerTickSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Policies by class, the first policy matching a class is used */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick")
+	TArray<FRunnerTickPolicy> Policies;
+
+	/** Spawned objects of these types do not tick unless a policy matches their class */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick")
+	TArray<ERunnerSpawnerType> DisabledSpawnerTypes;
+};
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerGenericStruct.h"
+#include "RunnerTickSettings.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RunnerTickSubsystem.generated.h"
+
+/**
+ *  Enforces the tick policies of URunnerTickSettings on tiles and spawned objects as they are created.
+ *
+ *  Outside shipping builds it also audits the ticking actors and components of the world:
+ *  Runner.TickAudit logs them per class, Runner.TickAudit.Measure [Classes] estimates the game thread cost
+ *  of the classes with the most ticks by disabling their ticks for a while and comparing the frame times.
+ *  Only ticks on tiles and spawned objects are disabled, the player keeps running during the measurement.
+ *  -RunnerTickAudit runs the measurement once the game has been running for a few seconds.
+ */
+UCLASS()
+class RUNNER_API URunnerTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Apply the class policies to the actor and its components */
+	void ApplyToActor(AActor* Actor);
+
+	/** Apply the policies to a tile, its components and the child actors that are not spawned objects */
+	void ApplyToTile(AActor* Tile);
+
+	/** Apply the policies to an object spawned by a spawner of the given type */
+	void ApplyToSpawned(AActor* Actor, ERunnerSpawnerType SpawnerType);
+
+	/** Number of actors and components whose tick was changed by a policy */
+	int32 GetEnforcedCount() const { return EnforcedCount; }
+
+#if !UE_BUILD_SHIPPING
+	/** Log the ticking actors and components per class */
+	void LogAudit();
+
+	/** Measure the tick cost of the classes with the most ticks */
+	void StartMeasure(int32 MaxClasses);
+#endif
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Loaded policy classes, in the order of the settings */
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> PolicyClasses;
+
+	/** Policy of each entry of PolicyClasses */
+	TArray<FRunnerTickPolicy> ClassPolicies;
+
+	/** Index of the policy found for a class, INDEX_NONE if no policy matches */
+	TMap<const UClass*, int32> PolicyCache;
+
+	TArray<ERunnerSpawnerType> DisabledSpawnerTypes;
+
+	int32 EnforcedCount = 0;
+
+	const FRunnerTickPolicy* FindPolicy(const UClass* Class);
+
+#if !UE_BUILD_SHIPPING
+	/** Audit of one ticking class */
+	struct FTickAuditEntry
+	{
+		FName Class;
+
+		bool bComponent = false;
+
+		/** Actors or components that can tick */
+		int32 Count = 0;
+
+		/** Of those, the ones with their tick enabled */
+		int32 Enabled = 0;
+
+		/** Ticks per second of the enabled ones */
+		double TicksPerSecond = 0;
+
+		/** Enabled ones on tiles and spawned objects, the ones a measurement disables */
+		int32 MeasurableEnabled = 0;
+
+		double MeasurableTicksPerSecond = 0;
+
+		/** Game thread milliseconds per frame saved by disabling the measurable ones, negative if not measured */
+		double MeasuredMs = -1;
+	};
+
+	TMap<FName, FTickAuditEntry> Audit;
+
+	/** Classes still to measure */
+	TArray<FName> MeasureQueue;
+
+	/** Objects whose ticks were disabled for the measurement */
+	TArray<TWeakObjectPtr<UObject>> MeasureDisabled;
+
+	bool bMeasuringDisabled = false;
+
+	int32 MeasureFrame = 0;
+
+	double BaselineMs = 0;
+
+	double DisabledMs = 0;
+
+	/** Time until the measurement starts for -RunnerTickAudit */
+	float AutoMeasureDelay = -1;
+
+	/** Collect the ticking classes into Audit, keeping the measurements */
+	void GatherAudit();
+
+	/** Returns true for tiles and the objects on them, never for the player pawn or its controller */
+	bool IsMeasurable(const AActor* Actor) const;
+
+	/** Disable or restore the ticks of the class being measured */
+	void SetMeasuredClassEnabled(bool bEnabled);
+#endif
+};
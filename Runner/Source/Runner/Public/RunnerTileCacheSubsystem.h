@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunnerGenericStruct.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RunnerTileCacheSubsystem.generated.h"
+
+class UChildActorComponent;
+class UStaticMesh;
+
+/**
+ *  Caches what is the same for every tile or object of a class: the floor extent, the offset of the attach point, the spawn grids
+ *  and the proxy meshes of spawned objects.
+ *  Each entry is built on first use, later tiles look it up instead of querying components and interfaces.
+ */
+UCLASS()
+class RUNNER_API URunnerTileCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Static mesh drawn in place of an actor class on far tiles */
+	struct FProxyMesh
+	{
+		/** Kept alive by the component template of the class */
+		UStaticMesh* Mesh = nullptr;
+
+		/** Transform of the mesh component relative to the spawn transform, only the scale when the mesh is the root */
+		FTransform RelativeTransform;
+	};
+
+	/** Returns the scaled extent of the floor mesh in the child actor, cached per child actor class and scale */
+	FVector GetFloorExtent(const UChildActorComponent* AttachParent);
+
+	/** Returns the offset from the tile location to the attach point of the next tile, cached per tile class */
+	FVector GetAttachOffset(AActor* Tile);
+
+	/** Returns the spawn grid of the settings on a floor with the given extent, cached per grid layout, only used by shapes without a spawn policy */
+	TConstArrayView<FTransform> GetSpawnGrid(const FSpawnSettings& Settings, const FVector& FloorExtent);
+
+	/** Returns the first static mesh of the actor class, cached per class, nullptr if the class has none */
+	const FProxyMesh* GetProxyMesh(UClass* ActorClass);
+
+	/** Computes the scaled extent of the floor mesh in the child actor */
+	static FVector ComputeFloorExtent(const UChildActorComponent* AttachParent);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawn grid and the settings it was generated from */
+	struct FSpawnGridEntry
+	{
+		FVector FloorExtent = FVector::ZeroVector;
+		int32 PointsPerLane = 0;
+		int32 XOffset = 0;
+		int32 ZOffset = 0;
+		FRotator ActorRotator = FRotator::ZeroRotator;
+		TArray<float> LaneYOffsets;
+
+		TArray<FTransform> Grid;
+
+		bool Matches(const FSpawnSettings& Settings, const FVector& InFloorExtent) const;
+	};
+
+	/** Floor extent by child actor class and component scale */
+	TMap<TPair<FObjectKey, FVector>, FVector> FloorExtents;
+
+	/** Attach offset by tile class */
+	TMap<FObjectKey, FVector> AttachOffsets;
+
+	/** Proxy mesh by actor class, without a mesh if the class has none */
+	TMap<FObjectKey, FProxyMesh> ProxyMeshes;
+
+	/** Spawn grids by hash of the grid layout */
+	TMap<uint32, FSpawnGridEntry> SpawnGrids;
+
+	/** Grid handed out on hash collisions */
+	TArray<FTransform> UncachedGrid;
+
+	static uint32 HashGridLayout(const FSpawnSettings& Settings, const FVector& FloorExtent);
+};
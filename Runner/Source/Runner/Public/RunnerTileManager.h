@@ -15,6 +15,10 @@ class RUNNER_API URunnerTileManager : public UActorComponent
 	GENERATED_BODY()
 
 public:
+	URunnerTileManager();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default")
 	TSubclassOf<AActor> TileClass;
 	
@@ -30,6 +34,42 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default")
 	FVector FirstTileLocation;
 
+	/** The tiles are skyline tiles, their memory is tracked under the skyline tag instead of the tiles tag */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default")
+	bool bIsSkyline = false;
+
+	/** Seed of the random stream used for tile layouts, 0 picks a random seed per run */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default")
+	int32 RandomSeed = 0;
+
+	/** Tiles farther ahead of the player than this only plan their objects and show proxies, 0 spawns the objects of every tile right away */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default|Materialization", meta = (ClampMin = "0"))
+	float MaterializeDistance = 0.0f;
+
+	/** Spawners materialized per frame at most, tiles within half the distance are materialized regardless */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default|Materialization", meta = (ClampMin = "1"))
+	int32 MaterializeSpawnersPerFrame = 2;
+
+	/** Spawned objects this far behind the player are removed before their tile is, 0 keeps them until the tile is removed */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default|Reclamation", meta = (ClampMin = "0"))
+	float ReclaimDistance = 0.0f;
+
+	/** Seconds between checks for objects to reclaim */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Default|Reclamation", meta = (ClampMin = "0"))
+	float ReclaimInterval = 0.1f;
+
+	/** Number of objects removed before their tile */
+	int32 GetReclaimedCount() const { return ReclaimedCount; }
+
+	/** Returns true if a tile at the location should plan its objects instead of spawning them */
+	bool ShouldDeferObjects(const FVector& TileLocation) const;
+
+	/** Random stream used for tile layouts */
+	const FRandomStream& GetRandomStream() const { return RandomStream; }
+
+	/** Tiles currently in the world, ordered from the oldest to the newest */
+	const TArray<AActor*>& GetTileActors() const { return TileActorArray; }
+
 	UFUNCTION(BlueprintCallable)
 	void ExtendTile();
 
@@ -43,6 +83,27 @@ protected:
 	UPROPERTY(BlueprintReadWrite, Category = "Default")
 	TArray<AActor*> TileActorArray;
 
+	FRandomStream RandomStream;
+
+	/** Tiles with planned objects, ordered from the nearest to the farthest */
+	TArray<TWeakObjectPtr<AActor>> PendingTiles;
+
+	/** Returns the track position of the player, the first tile location while there is no player */
+	double GetPlayerTrackX() const;
+
+	/** Spawn the planned objects of the tiles the player is getting close to */
+	void MaterializeTiles();
+
+	float TimeUntilReclaim = 0.0f;
+
+	int32 ReclaimedCount = 0;
+
+	/** Remove the spawned objects more than ReclaimDistance behind the player */
+	void ReclaimPassedObjects();
+
+	/** Returns the LLM tag of the tiles */
+	FName GetMemoryTag() const;
+
 	UFUNCTION(BlueprintCallable)
 	void AddTile();
 
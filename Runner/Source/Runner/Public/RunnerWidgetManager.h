@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "RunnerWidgetManager.generated.h"
+
+class UUserWidget;
+
+/**
+ *  Creates each widget class once and keeps the instances cached.
+ *  Widgets are switched by visibility and stacked by layer instead of being recreated.
+ */
+UCLASS()
+class RUNNER_API URunnerWidgetManager : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	URunnerWidgetManager();
+
+	/**
+	 *  Show the cached instance of the widget class on the given layer, creating it on first use.
+	 *  Showing a hidden widget only restores its visibility and does not run Construct again,
+	 *  pass bReconstruct for widgets that reset their state in Construct.
+	 */
+	UFUNCTION(BlueprintCallable)
+	UUserWidget* ShowWidget(TSubclassOf<UUserWidget> WidgetClass, int32 Layer = 0, bool bReconstruct = false);
+
+	/** Hide the cached instance of the widget class */
+	UFUNCTION(BlueprintCallable)
+	void HideWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+	/** Returns true if the cached instance of the widget class is on screen */
+	UFUNCTION(BlueprintCallable)
+	bool IsWidgetVisible(TSubclassOf<UUserWidget> WidgetClass) const;
+
+	/** Returns the cached instance of the widget class, nullptr if it was never created */
+	UFUNCTION(BlueprintCallable)
+	UUserWidget* FindWidget(TSubclassOf<UUserWidget> WidgetClass) const;
+
+	/** Create the widget instance ahead of time so it is not created mid-run */
+	UFUNCTION(BlueprintCallable)
+	void PrecreateWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+	/** Returns the number of cached widget instances */
+	UFUNCTION(BlueprintCallable)
+	int32 GetCachedWidgetCount() const { return CachedWidgets.Num(); }
+
+	/** Log cached widgets and the number of live user widgets in the world */
+	UFUNCTION(BlueprintCallable)
+	void ReportWidgets() const;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Widget instances keyed by class */
+	UPROPERTY()
+	TMap<TSubclassOf<UUserWidget>, TObjectPtr<UUserWidget>> CachedWidgets;
+
+	/** Layer each cached widget was last added to the viewport on */
+	TMap<TSubclassOf<UUserWidget>, int32> WidgetLayers;
+
+	/** Returns the cached widget instance, creating it on first use */
+	UUserWidget* GetOrCreateWidget(const TSubclassOf<UUserWidget>& WidgetClass);
+};
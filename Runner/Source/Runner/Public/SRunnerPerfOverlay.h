@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+/**
+ *  Data drawn by the performance overlay, written by URunnerPerfOverlaySubsystem
+ */
+struct FRunnerPerfOverlayData
+{
+	/** Ring buffer of the latest frame times in milliseconds */
+	TArray<float> FrameTimesMs;
+
+	/** Index the next frame time is written to */
+	int32 FrameHead = 0;
+
+	/** Text lines, rebuilt a few times per second */
+	TArray<FString> Lines;
+};
+
+/**
+ *  Draws a frame time graph and the overlay text lines directly as draw elements, without child widgets
+ */
+class RUNNER_API SRunnerPerfOverlay : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SRunnerPerfOverlay)
+		{}
+		SLATE_ARGUMENT(TSharedPtr<const FRunnerPerfOverlayData>, Data)		/** Data to draw */
+	SLATE_END_ARGS()
+
+	/** Constructs this widget with InArgs */
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	TSharedPtr<const FRunnerPerfOverlayData> Data;
+
+	FSlateFontInfo Font;
+
+	/** Reused graph points so painting does not allocate */
+	mutable TArray<FVector2D> GraphPoints;
+};
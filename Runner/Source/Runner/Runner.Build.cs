@@ -15,6 +15,14 @@ public class Runner : ModuleRules
 			"UMG",						// Used for widget creation
 			"LoadingScreenModule"		// Used for loading screens
 		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			"Json",						// Benchmark reports
+			"RenderCore",				// Game thread time
+			"Slate",					// Performance overlay
+			"SlateCore"
+		});
 		
 		OptimizeCode = CodeOptimization.Never;  // remove from real game but we should have it in 
 	}